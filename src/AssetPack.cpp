@@ -0,0 +1,255 @@
+#include "AssetPack.h"
+#include <cstring>
+#include <cstdint>
+
+// Pack layout (little-endian, native struct layout):
+//   PackHeader, pageCount PageRecord, spriteCount SpriteRecord, then each
+//   page's RGBA8 pixels, row-major, at its record's offset (8-byte aligned)
+static const char PACK_MAGIC[4] = { 'L', 'P', 'A', 'K' };
+static const uint32_t PACK_VERSION = 1;
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t pageCount;
+    uint32_t spriteCount;
+};
+
+struct PageRecord {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+};
+
+struct SpriteRecord {
+    char name[44];  // zero padded
+    uint32_t page;
+    float x, y, width, height;
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout");
+static_assert(sizeof(PageRecord) == 16, "PageRecord layout");
+static_assert(sizeof(SpriteRecord) == 64, "SpriteRecord layout");
+
+// Source images, named after their file stem. Keyed images have their
+// magenta background made transparent; sheets are cut into frameWidth wide
+// frames named "<stem>.<index>".
+struct AssetSource {
+    const char* path;
+    bool colorKey;
+    int frameWidth;
+    // Not in the repository (extracted from a game install); packed when present
+    bool optional = false;
+};
+
+static const AssetSource ASSET_SOURCES[] = {
+    { "resources/background00.png", false, 0 },
+
+    // Tiles
+    { "resources/sidewalk.png", false, 0 },
+    { "resources/road2x2Horizontal.png", false, 0 },
+    { "resources/road2x2TurnRightDown.png", false, 0 },
+    { "resources/road2x2TDown.png", false, 0 },
+    { "resources/road2x2Cross.png", false, 0 },
+    { "resources/road2x2EndDown.png", false, 0 },
+    { "resources/railHorizontal.png", false, 0 },
+    { "resources/railTurnRightDown.png", false, 0 },
+
+    // Buildings
+    { "resources/redHouse.png", false, 0 },
+    { "resources/house.png", false, 0 },
+    { "resources/pizzaShop.png", false, 0 },
+
+    // Toybox animation (167px cells) and the opened tray, extracted from the original game
+    { "resources/raw/toybox.bmp", true, 167, true },
+    { "resources/raw/tray.bmp", true, 0, true },
+};
+
+static std::string FileStem(const char* path) {
+    std::string name = path;
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos) name = name.substr(0, dot);
+    return name;
+}
+
+void AssetPack::ReleaseImages() {
+    if (ownsImages) {
+        for (Image& image : pageImages) UnloadImage(image);
+    }
+    pageImages.clear();
+    ownsImages = false;
+    file.Close();
+}
+
+bool AssetPack::Load(const std::string& path) {
+    Unload();
+    if (!file.Open(path)) {
+        lastError = "Cannot open " + path;
+        return false;
+    }
+    const unsigned char* data = file.Data();
+    size_t size = file.Size();
+
+    PackHeader header;
+    if (size < sizeof(header)) {
+        lastError = "Truncated asset pack";
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header.version != PACK_VERSION) {
+        lastError = "Not an asset pack of version " + std::to_string(PACK_VERSION);
+        return false;
+    }
+    uint64_t tableSize = (uint64_t)header.pageCount * sizeof(PageRecord) +
+                         (uint64_t)header.spriteCount * sizeof(SpriteRecord);
+    if (tableSize > size - sizeof(header)) {
+        lastError = "Truncated asset pack";
+        return false;
+    }
+
+    const unsigned char* cursor = data + sizeof(header);
+    for (uint32_t i = 0; i < header.pageCount; i++) {
+        PageRecord page;
+        memcpy(&page, cursor, sizeof(page));
+        cursor += sizeof(page);
+        uint64_t bytes = (uint64_t)page.width * page.height * 4;
+        if (page.offset > size || bytes > size - page.offset) {
+            lastError = "Asset pack page runs past the end of the file";
+            pageImages.clear();
+            return false;
+        }
+        // raylib only reads the pixels when uploading, so they stay in the mapping
+        Image image = {};
+        image.data = const_cast<unsigned char*>(data + page.offset);
+        image.width = (int)page.width;
+        image.height = (int)page.height;
+        image.mipmaps = 1;
+        image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        pageImages.push_back(image);
+    }
+
+    for (uint32_t i = 0; i < header.spriteCount; i++) {
+        SpriteRecord record;
+        memcpy(&record, cursor, sizeof(record));
+        cursor += sizeof(record);
+        if (record.page >= header.pageCount) continue;
+        record.name[sizeof(record.name) - 1] = '\0';
+        sprites[record.name] = Sprite{ (int)record.page, { record.x, record.y, record.width, record.height } };
+    }
+    return true;
+}
+
+bool AssetPack::LoadSources() {
+    Unload();
+    skipped.clear();
+    bool complete = true;
+    SpriteAtlas atlas;
+    std::vector<std::pair<std::string, int>> handles;
+
+    for (const AssetSource& source : ASSET_SOURCES) {
+        Image image = LoadImage(source.path);
+        if (image.data == nullptr && source.optional) {
+            skipped.push_back(source.path);
+            continue;
+        }
+        if (image.data == nullptr) {
+            lastError = std::string("Missing ") + source.path;
+            complete = false;
+            continue;
+        }
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (source.colorKey) {
+            ImageColorReplace(&image, {255, 0, 255, 255}, {0, 0, 0, 0});
+        }
+
+        std::string name = FileStem(source.path);
+        if (source.frameWidth <= 0) {
+            handles.emplace_back(name, atlas.Add(image));
+            continue;
+        }
+        int frames = image.width / source.frameWidth;
+        for (int i = 0; i < frames; i++) {
+            Image frame = ImageFromImage(image, { (float)(i * source.frameWidth), 0,
+                                                  (float)source.frameWidth, (float)image.height });
+            handles.emplace_back(name + "." + std::to_string(i), atlas.Add(frame));
+        }
+        UnloadImage(image);
+    }
+
+    atlas.Pack();
+    for (const auto& [name, handle] : handles) {
+        sprites[name] = Sprite{ atlas.GetPage(handle), atlas.GetRect(handle) };
+    }
+    pageImages = atlas.TakePages();
+    ownsImages = true;
+    return complete;
+}
+
+bool AssetPack::Write(const std::string& path) const {
+    uint64_t offset = sizeof(PackHeader) + pageImages.size() * sizeof(PageRecord) +
+                      sprites.size() * sizeof(SpriteRecord);
+    std::vector<PageRecord> pageRecords;
+    for (const Image& image : pageImages) {
+        if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return false;
+        offset = (offset + 7) & ~(uint64_t)7;
+        pageRecords.push_back({ (uint32_t)image.width, (uint32_t)image.height, offset });
+        offset += (uint64_t)image.width * image.height * 4;
+    }
+
+    std::vector<unsigned char> buffer(offset, 0);
+    PackHeader header = {
+        {PACK_MAGIC[0], PACK_MAGIC[1], PACK_MAGIC[2], PACK_MAGIC[3]},
+        PACK_VERSION, (uint32_t)pageImages.size(), (uint32_t)sprites.size()
+    };
+    unsigned char* cursor = buffer.data();
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    memcpy(cursor, pageRecords.data(), pageRecords.size() * sizeof(PageRecord));
+    cursor += pageRecords.size() * sizeof(PageRecord);
+
+    for (const auto& [name, sprite] : sprites) {
+        if (name.size() >= sizeof(SpriteRecord::name)) return false;
+        SpriteRecord record = {};
+        memcpy(record.name, name.data(), name.size());
+        record.page = (uint32_t)sprite.page;
+        record.x = sprite.rect.x;
+        record.y = sprite.rect.y;
+        record.width = sprite.rect.width;
+        record.height = sprite.rect.height;
+        memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+
+    for (size_t i = 0; i < pageImages.size(); i++) {
+        memcpy(buffer.data() + pageRecords[i].offset, pageImages[i].data,
+               (size_t)pageImages[i].width * pageImages[i].height * 4);
+    }
+    return WriteFileAtomic(path, buffer.data(), buffer.size());
+}
+
+void AssetPack::Upload() {
+    for (const Image& image : pageImages) {
+        pages.push_back(LoadTextureFromImage(image));
+    }
+    ReleaseImages();
+}
+
+void AssetPack::Unload() {
+    for (Texture2D& page : pages) {
+        UnloadTexture(page);
+    }
+    pages.clear();
+    sprites.clear();
+    ReleaseImages();
+}
+
+AtlasSprite AssetPack::Get(const std::string& name) const {
+    auto it = sprites.find(name);
+    if (it == sprites.end()) return AtlasSprite{};
+    AtlasSprite sprite;
+    sprite.source = it->second.rect;
+    if (it->second.page < (int)pages.size()) sprite.texture = pages[it->second.page];
+    return sprite;
+}
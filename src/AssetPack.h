@@ -0,0 +1,57 @@
+#pragma once
+
+#include "raylib.h"
+#include "SpriteAtlas.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Every sprite the game draws, packed into atlas pages. The pages are baked
+// ahead of time by tools/pack_assets (magenta keyed, sliced and packed) into
+// one file that loads with a single read and no image decoding. Without a
+// pack file the same work runs from the source images at startup.
+class AssetPack {
+private:
+    struct Sprite {
+        int page;
+        Rectangle rect;
+    };
+
+    // Page pixels until Upload: owned images, or views into the mapped pack file
+    std::vector<Image> pageImages;
+    bool ownsImages = false;
+    MappedFile file;
+
+    std::vector<Texture2D> pages;
+    std::unordered_map<std::string, Sprite> sprites;
+    std::string lastError;
+    std::vector<std::string> skipped;
+
+    void ReleaseImages();
+
+public:
+    static constexpr const char* DEFAULT_PATH = "resources/assets.pack";
+
+    AssetPack() = default;
+    ~AssetPack() { ReleaseImages(); }
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Reads a baked pack; no window is needed until Upload
+    bool Load(const std::string& path);
+    // Decodes, keys, slices and packs the source images (what the pack tool bakes).
+    // Missing optional sources are skipped and listed in GetSkipped.
+    bool LoadSources();
+    bool Write(const std::string& path) const;
+    // Creates the page textures and drops the CPU copies; needs a window
+    void Upload();
+    void Unload();
+
+    // Texture is only set after Upload; the source rectangle is valid once loaded
+    AtlasSprite Get(const std::string& name) const;
+    int GetPageCount() const { return (int)(pages.empty() ? pageImages.size() : pages.size()); }
+    int GetSpriteCount() const { return (int)sprites.size(); }
+    const std::string& GetLastError() const { return lastError; }
+    const std::vector<std::string>& GetSkipped() const { return skipped; }
+};
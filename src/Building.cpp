@@ -51,30 +51,3 @@ const char* GetBuildingName(BuildingType type) {
         default:                      return "Unknown";
     }
 }
-
-void BuildingTextures::Load() {
-    textures[BuildingType::RedHouse] = LoadTexture("resources/redHouse.png");
-    textures[BuildingType::House] = LoadTexture("resources/house.png");
-    textures[BuildingType::PizzaShop] = LoadTexture("resources/pizzaShop.png");
-    loaded = true;
-}
-
-void BuildingTextures::Unload() {
-    for (auto& [type, texture] : textures) {
-        UnloadTexture(texture);
-    }
-    textures.clear();
-    loaded = false;
-}
-
-bool BuildingTextures::HasTexture(BuildingType type) const {
-    return textures.find(type) != textures.end();
-}
-
-Texture2D BuildingTextures::Get(BuildingType type) const {
-    auto it = textures.find(type);
-    if (it != textures.end()) {
-        return it->second;
-    }
-    return Texture2D{};
-}
@@ -1,8 +1,6 @@
 #pragma once
 
-#include "raylib.h"
 #include "Placeable.h"
-#include <unordered_map>
 
 enum class BuildingType {
     None,
@@ -10,6 +8,7 @@ enum class BuildingType {
     House,
     PizzaShop
 };
+const int BUILDING_TYPE_COUNT = 4;
 
 struct Building : Placeable {
     BuildingType type = BuildingType::None;
@@ -17,16 +16,3 @@ struct Building : Placeable {
 
 Building CreateBuilding(BuildingType type, int gridX, int gridY);
 const char* GetBuildingName(BuildingType type);
-
-class BuildingTextures {
-private:
-    std::unordered_map<BuildingType, Texture2D> textures;
-    bool loaded = false;
-
-public:
-    void Load();
-    void Unload();
-    bool HasTexture(BuildingType type) const;
-    Texture2D Get(BuildingType type) const;
-    bool IsLoaded() const { return loaded; }
-};
@@ -0,0 +1,28 @@
+#include "BuildingTextures.h"
+#include "Tile.h"
+#include "AssetPack.h"
+#include <algorithm>
+#include <iterator>
+
+void BuildingTextures::Load(const AssetPack& assets) {
+    sprites[static_cast<int>(BuildingType::None)] = AtlasSprite{};
+    sprites[static_cast<int>(BuildingType::RedHouse)] = assets.Get("redHouse");
+    sprites[static_cast<int>(BuildingType::House)] = assets.Get("house");
+    sprites[static_cast<int>(BuildingType::PizzaShop)] = assets.Get("pizzaShop");
+
+    // Culling has to widen the view by this much to catch roofs of off-screen footprints
+    maxOverhang = 0;
+    for (int i = 0; i < BUILDING_TYPE_COUNT; i++) {
+        if (!sprites[i].IsValid()) continue;
+        Building b = CreateBuilding(static_cast<BuildingType>(i), 0, 0);
+        int right = b.renderOffsetX + (int)sprites[i].source.width - b.width * TILE_SIZE;
+        int bottom = b.renderOffsetY + (int)sprites[i].source.height - b.height * TILE_SIZE;
+        maxOverhang = std::max({maxOverhang, -b.renderOffsetX, -b.renderOffsetY, right, bottom});
+    }
+    loaded = true;
+}
+
+void BuildingTextures::Unload() {
+    std::fill(std::begin(sprites), std::end(sprites), AtlasSprite{});
+    loaded = false;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "raylib.h"
+#include "Building.h"
+#include "SpriteAtlas.h"
+
+class AssetPack;
+
+class BuildingTextures {
+private:
+    // Sprites from the asset pack, indexed densely by type
+    AtlasSprite sprites[BUILDING_TYPE_COUNT];
+    bool loaded = false;
+    // Furthest any loaded sprite reaches past its footprint, in pixels
+    int maxOverhang = 0;
+
+public:
+    // Looks the sprites up once; the pack owns their textures
+    void Load(const AssetPack& assets);
+    void Unload();
+    bool HasTexture(BuildingType type) const { return Get(type).IsValid(); }
+    const AtlasSprite& Get(BuildingType type) const { return sprites[static_cast<int>(type)]; }
+    bool IsLoaded() const { return loaded; }
+    int GetMaxOverhang() const { return maxOverhang; }
+};
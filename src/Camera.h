@@ -2,6 +2,8 @@
 
 #include "raylib.h"
 #include "Tile.h"
+#include <algorithm>
+#include <cmath>
 
 Vector2 WorldToScreen(int gridX, int gridY, Vector2 cameraOffset, float zoom);
 Vector2 ScreenToWorld(Vector2 screenPos, Vector2 cameraOffset, float zoom);
@@ -12,16 +14,51 @@ public:
     float zoom;
     float minZoom = 1.0f;
     float maxZoom = 3.0f;
+    // World extent in pixels at 1x; panning stops at its edges (0 = unbounded)
+    float worldWidth = 0.0f;
+    float worldHeight = 0.0f;
+    float keyPanSpeed = 600.0f;  // screen pixels per second
 
     GameCamera() : offset{0.0f, 0.0f}, zoom(1.0f) {}
 
+    void SetWorldSize(int rows, int cols) {
+        worldWidth = (float)(cols * TILE_SIZE);
+        worldHeight = (float)(rows * TILE_SIZE);
+        ClampOffset();
+    }
+
+    // Keeps the screen inside the world (pinned to the top-left if the world is smaller)
+    void ClampOffset() {
+        if (worldWidth <= 0.0f || worldHeight <= 0.0f) return;
+        float minX = std::min(GetScreenWidth() - worldWidth * zoom, 0.0f);
+        float minY = std::min(GetScreenHeight() - worldHeight * zoom, 0.0f);
+        offset.x = std::clamp(offset.x, minX, 0.0f);
+        offset.y = std::clamp(offset.y, minY, 0.0f);
+    }
+
+    // Grid cells covered by the screen, widened by margin cells and clamped to
+    // rows x cols (inclusive). Returns false if none are visible.
+    bool VisibleCells(int rows, int cols, int margin, int& x0, int& y0, int& x1, int& y1) const {
+        float cellSize = TILE_SIZE * zoom;
+        x0 = std::max((int)floorf(-offset.x / cellSize) - margin, 0);
+        y0 = std::max((int)floorf(-offset.y / cellSize) - margin, 0);
+        x1 = std::min((int)floorf((GetScreenWidth() - offset.x) / cellSize) + margin, cols - 1);
+        y1 = std::min((int)floorf((GetScreenHeight() - offset.y) / cellSize) + margin, rows - 1);
+        return x0 <= x1 && y0 <= y1;
+    }
+
     void Update() {
-        // Pan with middle mouse drag (only when zoomed in)
-        if (IsMouseButtonDown(MOUSE_BUTTON_MIDDLE) && zoom > 1.0f) {
+        // Pan with middle mouse drag or the arrow keys
+        if (IsMouseButtonDown(MOUSE_BUTTON_MIDDLE)) {
             Vector2 delta = GetMouseDelta();
             offset.x += delta.x;
             offset.y += delta.y;
         }
+        float step = keyPanSpeed * GetFrameTime();
+        if (IsKeyDown(KEY_LEFT)) offset.x += step;
+        if (IsKeyDown(KEY_RIGHT)) offset.x -= step;
+        if (IsKeyDown(KEY_UP)) offset.y += step;
+        if (IsKeyDown(KEY_DOWN)) offset.y -= step;
 
         // Zoom with mouse wheel
         float wheel = GetMouseWheelMove();
@@ -33,14 +70,10 @@ public:
             if (zoom < minZoom) zoom = minZoom;
             if (zoom > maxZoom) zoom = maxZoom;
 
-            // Reset offset when at default zoom
-            if (zoom <= 1.0f) {
-                offset = {0.0f, 0.0f};
-            } else {
-                Vector2 screenAfterZoom = WorldToScreen((int)worldBeforeZoom.x, (int)worldBeforeZoom.y, offset, zoom);
-                offset.x += mousePos.x - screenAfterZoom.x;
-                offset.y += mousePos.y - screenAfterZoom.y;
-            }
+            // Keep the point under the cursor in place
+            offset.x = mousePos.x - worldBeforeZoom.x * TILE_SIZE * zoom;
+            offset.y = mousePos.y - worldBeforeZoom.y * TILE_SIZE * zoom;
         }
+        ClampOffset();
     }
 };
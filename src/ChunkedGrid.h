@@ -0,0 +1,161 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+// Sparse row-major grid stored in CHUNK_SIZE x CHUNK_SIZE chunks. A chunk is
+// allocated on the first write of a non-default value and freed again once
+// every cell in it is back to the default, so memory follows the occupied area
+// rather than the grid extent. Unallocated cells read as the default value.
+// Values are compared bytewise, so T must be trivially copyable.
+template <typename T>
+class ChunkedGrid {
+public:
+    static const int CHUNK_SHIFT = 6;
+    static const int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+    static const int CHUNK_MASK = CHUNK_SIZE - 1;
+    static const int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+    struct Chunk {
+        T cells[CHUNK_CELLS];  // row-major within the chunk
+        int used = 0;          // cells holding a non-default value
+    };
+
+private:
+    int rows = 0;
+    int cols = 0;
+    int chunkRows = 0;
+    int chunkCols = 0;
+    T fill{};
+    std::vector<std::unique_ptr<Chunk>> chunks;  // chunkRows x chunkCols, null when all default
+    size_t allocated = 0;
+
+    bool IsFill(const T& value) const { return memcmp(&value, &fill, sizeof(T)) == 0; }
+    size_t ChunkIndex(int x, int y) const { return (size_t)(y >> CHUNK_SHIFT) * chunkCols + (x >> CHUNK_SHIFT); }
+    static int CellIndex(int x, int y) { return ((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK); }
+
+public:
+    ChunkedGrid() = default;
+    ChunkedGrid(int rows, int cols, const T& fill = T{}) { Reset(rows, cols, fill); }
+
+    ChunkedGrid(const ChunkedGrid& other) { *this = other; }
+    ChunkedGrid& operator=(const ChunkedGrid& other) {
+        if (this == &other) return *this;
+        rows = other.rows;
+        cols = other.cols;
+        chunkRows = other.chunkRows;
+        chunkCols = other.chunkCols;
+        fill = other.fill;
+        allocated = other.allocated;
+        chunks.clear();
+        chunks.resize(other.chunks.size());
+        for (size_t i = 0; i < chunks.size(); i++) {
+            if (other.chunks[i]) chunks[i].reset(new Chunk(*other.chunks[i]));
+        }
+        return *this;
+    }
+    ChunkedGrid(ChunkedGrid&&) = default;
+    ChunkedGrid& operator=(ChunkedGrid&&) = default;
+
+    // Resizes and frees every chunk
+    void Reset(int newRows, int newCols, const T& newFill = T{}) {
+        rows = newRows;
+        cols = newCols;
+        fill = newFill;
+        chunkRows = (rows + CHUNK_MASK) >> CHUNK_SHIFT;
+        chunkCols = (cols + CHUNK_MASK) >> CHUNK_SHIFT;
+        chunks.clear();
+        chunks.resize((size_t)chunkRows * chunkCols);
+        allocated = 0;
+    }
+    void Clear() { Reset(rows, cols, fill); }
+
+    int GetRows() const { return rows; }
+    int GetCols() const { return cols; }
+    int GetChunkRows() const { return chunkRows; }
+    int GetChunkCols() const { return chunkCols; }
+    const T& GetFill() const { return fill; }
+    size_t GetChunkCount() const { return allocated; }
+    size_t GetMemoryBytes() const { return allocated * sizeof(Chunk) + chunks.size() * sizeof(chunks[0]); }
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < cols && y >= 0 && y < rows; }
+
+    // Unchecked read; callers must stay within bounds
+    const T& At(int x, int y) const {
+        const Chunk* chunk = chunks[ChunkIndex(x, y)].get();
+        return chunk ? chunk->cells[CellIndex(x, y)] : fill;
+    }
+    // Bounds-checked read; cells outside the grid read as the default
+    const T& Get(int x, int y) const { return InBounds(x, y) ? At(x, y) : fill; }
+
+    // Unchecked write; allocates or frees the cell's chunk as needed
+    void Set(int x, int y, const T& value) {
+        std::unique_ptr<Chunk>& chunk = chunks[ChunkIndex(x, y)];
+        bool isFill = IsFill(value);
+        if (!chunk) {
+            if (isFill) return;
+            chunk.reset(new Chunk);
+            std::fill(std::begin(chunk->cells), std::end(chunk->cells), fill);
+            allocated++;
+        }
+        T& cell = chunk->cells[CellIndex(x, y)];
+        chunk->used += (int)IsFill(cell) - (int)isFill;
+        cell = value;
+        if (chunk->used == 0) {
+            chunk.reset();
+            allocated--;
+        }
+    }
+
+    // Chunk at chunk coordinates, or null if every cell in it is the default
+    const Chunk* GetChunk(int cx, int cy) const { return chunks[(size_t)cy * chunkCols + cx].get(); }
+    bool HasChunk(int cx, int cy) const { return GetChunk(cx, cy) != nullptr; }
+    // Row y of chunk column cx (CHUNK_SIZE cells from x = cx * CHUNK_SIZE), or
+    // null if that chunk is unallocated
+    const T* ChunkRow(int cx, int y) const {
+        const Chunk* chunk = GetChunk(cx, y >> CHUNK_SHIFT);
+        return chunk ? chunk->cells + ((y & CHUNK_MASK) << CHUNK_SHIFT) : nullptr;
+    }
+    // True if any cell in the inclusive rectangle may hold a non-default value
+    bool HasChunksIn(int x0, int y0, int x1, int y1) const {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, cols - 1);
+        y1 = std::min(y1, rows - 1);
+        if (x0 > x1 || y0 > y1) return false;
+        for (int cy = y0 >> CHUNK_SHIFT; cy <= y1 >> CHUNK_SHIFT; cy++) {
+            for (int cx = x0 >> CHUNK_SHIFT; cx <= x1 >> CHUNK_SHIFT; cx++) {
+                if (HasChunk(cx, cy)) return true;
+            }
+        }
+        return false;
+    }
+
+    // Calls visit(cx, cy, chunk) for every allocated chunk in row-major chunk order.
+    // Edge chunks hold default cells past the grid's last row/column.
+    template <typename Visit>
+    void ForEachChunk(Visit&& visit) const {
+        for (int cy = 0; cy < chunkRows; cy++) {
+            for (int cx = 0; cx < chunkCols; cx++) {
+                const Chunk* chunk = GetChunk(cx, cy);
+                if (chunk) visit(cx, cy, *chunk);
+            }
+        }
+    }
+
+    // Calls visit(x, y, value) for every non-default cell, row-major within each chunk
+    template <typename Visit>
+    void ForEachSet(Visit&& visit) const {
+        ForEachChunk([&](int cx, int cy, const Chunk& chunk) {
+            int x0 = cx << CHUNK_SHIFT;
+            int y0 = cy << CHUNK_SHIFT;
+            for (int i = 0; i < CHUNK_CELLS; i++) {
+                if (!IsFill(chunk.cells[i])) visit(x0 + (i & CHUNK_MASK), y0 + (i >> CHUNK_SHIFT), chunk.cells[i]);
+            }
+        });
+    }
+};
@@ -0,0 +1,210 @@
+#include "ConnectionPlanes.h"
+#include <algorithm>
+#include <cstddef>
+
+// Row operations run on as many plane rows at once as the target has vector
+// lanes for; shifts by 64 or more give zero on every path
+#if defined(__AVX2__)
+#include <immintrin.h>
+typedef __m256i Rows;
+static const int LANES = 4;
+static inline Rows Load(const uint64_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+static inline void Store(uint64_t* p, Rows v) { _mm256_storeu_si256((__m256i*)p, v); }
+static inline Rows Or(Rows a, Rows b) { return _mm256_or_si256(a, b); }
+static inline Rows And(Rows a, Rows b) { return _mm256_and_si256(a, b); }
+static inline Rows Shr(Rows a, int n) { return _mm256_srl_epi64(a, _mm_cvtsi32_si128(n)); }
+static inline Rows Shl(Rows a, int n) { return _mm256_sll_epi64(a, _mm_cvtsi32_si128(n)); }
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+typedef __m128i Rows;
+static const int LANES = 2;
+static inline Rows Load(const uint64_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline void Store(uint64_t* p, Rows v) { _mm_storeu_si128((__m128i*)p, v); }
+static inline Rows Or(Rows a, Rows b) { return _mm_or_si128(a, b); }
+static inline Rows And(Rows a, Rows b) { return _mm_and_si128(a, b); }
+static inline Rows Shr(Rows a, int n) { return _mm_srl_epi64(a, _mm_cvtsi32_si128(n)); }
+static inline Rows Shl(Rows a, int n) { return _mm_sll_epi64(a, _mm_cvtsi32_si128(n)); }
+#else
+typedef uint64_t Rows;
+static const int LANES = 1;
+static inline Rows Load(const uint64_t* p) { return *p; }
+static inline void Store(uint64_t* p, Rows v) { *p = v; }
+static inline Rows Or(Rows a, Rows b) { return a | b; }
+static inline Rows And(Rows a, Rows b) { return a & b; }
+static inline Rows Shr(Rows a, int n) { return n < 64 ? a >> n : 0; }
+static inline Rows Shl(Rows a, int n) { return n < 64 ? a << n : 0; }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+// Byte 'shift / 8' of each of the sixteen tiles in v, one per byte lane
+static inline __m128i PackBytes(const __m128i v[4], int shift) {
+    const __m128i low = _mm_set1_epi32(0xFF);
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    __m128i a = _mm_and_si128(_mm_srl_epi32(v[0], count), low);
+    __m128i b = _mm_and_si128(_mm_srl_epi32(v[1], count), low);
+    __m128i c = _mm_and_si128(_mm_srl_epi32(v[2], count), low);
+    __m128i d = _mm_and_si128(_mm_srl_epi32(v[3], count), low);
+    return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+#endif
+
+void ConnectionPlanes::ClassifyRow(const Tile* cells, ChunkPlanes& chunk, int r) const {
+    // Collected in locals: tiles are bytes, so writes through chunk could alias them
+    uint64_t types[TILE_TYPE_COUNT] = {};
+    uint64_t anchors = 0;
+    uint64_t stored = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    static_assert(sizeof(Tile) == 4 && offsetof(Tile, type) == 0 && offsetof(Tile, connections) == 1 &&
+                  offsetof(Tile, anchorOffset) == 3, "tiles are read as little-endian words");
+    // Sixteen tiles at a time, one mask bit each
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < ROWS; i += 16) {
+        __m128i v[4];
+        for (int j = 0; j < 4; j++) v[j] = _mm_loadu_si128((const __m128i*)(cells + i + 4 * j));
+        __m128i type = PackBytes(v, 0);
+        for (int k = 0; k < classifiedCount; k++) {
+            int t = classified[k];
+            types[t] |= (uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(type, _mm_set1_epi8((char)t))) << i;
+        }
+        int empty = _mm_movemask_epi8(_mm_cmpeq_epi8(type, zero));
+        int anchor = _mm_movemask_epi8(_mm_cmpeq_epi8(PackBytes(v, 24), zero));
+        int unset = _mm_movemask_epi8(_mm_cmpeq_epi8(PackBytes(v, 8), zero));
+        anchors |= (uint64_t)(anchor & ~empty & 0xFFFF) << i;
+        stored |= (uint64_t)(~unset & 0xFFFF) << i;
+    }
+#else
+    for (int i = 0; i < ROWS; i++) {
+        const Tile& tile = cells[i];
+        if (tile.type == TileType::Empty) continue;
+        uint64_t bit = 1ull << i;
+        types[(int)tile.type] |= bit;
+        if (tile.IsAnchor()) anchors |= bit;
+        if (tile.connections != CONN_NONE) stored |= bit;
+    }
+#endif
+    for (int k = 0; k < classifiedCount; k++) chunk.types[classified[k]][r] = types[classified[k]];
+    chunk.anchors[r] = anchors;
+    chunk.stored[r] = stored;
+}
+
+// Neighbour rows kept around a chunk: one above, and below up to the tallest footprint
+static const int PADDED_ROWS = ConnectionPlanes::ROWS + 1 + MAX_TILE_SPAN;
+static_assert(ConnectionPlanes::ROWS % LANES == 0 && PADDED_ROWS % LANES == 0, "rows must fill whole lanes");
+
+void ConnectionPlanes::GatherRows(uint32_t typeMask, int cx, int y, int count, uint64_t* out) const {
+    // One run per chunk the rows cross
+    for (int n = 0; n < count;) {
+        int row = y + n;
+        int cy = row >= 0 ? row / ROWS : -1;
+        int start = row >= 0 ? row % ROWS : 0;
+        int run = std::min(row >= 0 ? ROWS - start : -row, count - n);
+        bool inside = cx >= 0 && cx < chunkCols && cy >= 0 && cy < chunkRows;
+        int slot = inside ? slotOf[(size_t)cy * chunkCols + cx] : -1;
+        for (int k = 0; k < run; k++) out[n + k] = 0;
+        if (slot >= 0) {
+            for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+                if (!(typeMask & (1u << t))) continue;
+                const uint64_t* plane = planes[slot].types[t] + start;
+                for (int k = 0; k < run; k++) out[n + k] |= plane[k];
+            }
+        }
+        n += run;
+    }
+}
+
+void ConnectionPlanes::Connect(ChunkPlanes& chunk, TileType type) {
+    int w = GetTileWidth(type);
+    int h = GetTileHeight(type);
+    uint32_t neighbors = 0;
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        if (CanTilesConnect(type, (TileType)t)) neighbors |= 1u << t;
+    }
+
+    // Cells this type connects to in rows -1 .. ROWS + MAX_TILE_SPAN - 1 of
+    // this chunk and of the chunks either side, for bits shifted across
+    uint64_t mid[PADDED_ROWS], west[PADDED_ROWS], east[PADDED_ROWS];
+    int y0 = chunk.cy * ROWS - 1;
+    GatherRows(neighbors, chunk.cx, y0, PADDED_ROWS, mid);
+    GatherRows(neighbors, chunk.cx - 1, y0, PADDED_ROWS, west);
+    GatherRows(neighbors, chunk.cx + 1, y0, PADDED_ROWS, east);
+
+    // Fold the top and bottom edges: bit x of across[r] is set if any of
+    // cells x .. x + w - 1 in padded row r connects
+    uint64_t across[PADDED_ROWS];
+    for (int r = 0; r < PADDED_ROWS; r += LANES) {
+        Rows cells = Load(mid + r);
+        Rows next = Load(east + r);
+        Rows folded = cells;
+        for (int d = 1; d < w; d++) folded = Or(folded, Or(Shr(cells, d), Shl(next, 64 - d)));
+        Store(across + r, folded);
+    }
+
+    uint64_t* self = chunk.types[(int)type];
+    for (int r = 0; r < ROWS; r += LANES) {
+        Rows anchors = And(Load(self + r), Load(chunk.anchors + r));
+
+        // Fold the left and right edges over the footprint height
+        Rows midSide = Load(mid + r + 1);
+        Rows westSide = Load(west + r + 1);
+        Rows eastSide = Load(east + r + 1);
+        for (int d = 1; d < h; d++) {
+            midSide = Or(midSide, Load(mid + r + 1 + d));
+            westSide = Or(westSide, Load(west + r + 1 + d));
+            eastSide = Or(eastSide, Load(east + r + 1 + d));
+        }
+
+        Rows up = Load(across + r);
+        Rows down = Load(across + r + 1 + h);
+        Rows left = Or(Shl(midSide, 1), Shr(westSide, 63));
+        Rows right = Or(Shr(midSide, w), Shl(eastSide, 64 - w));
+        Store(chunk.up + r, Or(Load(chunk.up + r), And(up, anchors)));
+        Store(chunk.down + r, Or(Load(chunk.down + r), And(down, anchors)));
+        Store(chunk.left + r, Or(Load(chunk.left + r), And(left, anchors)));
+        Store(chunk.right + r, Or(Load(chunk.right + r), And(right, anchors)));
+    }
+}
+
+void ConnectionPlanes::Build(const TileGrid& tiles) {
+    rows = tiles.GetRows();
+    chunkRows = tiles.GetChunkRows();
+    chunkCols = tiles.GetChunkCols();
+    slotOf.assign((size_t)chunkRows * chunkCols, -1);
+    planes.clear();
+    planes.reserve(tiles.GetChunkCount());
+
+    classifiedCount = 0;
+    for (int t = 1; t < TILE_TYPE_COUNT; t++) {
+        bool used = UsesAutoConnections((TileType)t);
+        for (int a = 1; a < TILE_TYPE_COUNT; a++) {
+            if (UsesAutoConnections((TileType)a) && CanTilesConnect((TileType)a, (TileType)t)) used = true;
+        }
+        if (used) classified[classifiedCount++] = t;
+    }
+
+    tiles.ForEachChunk([&](int cx, int cy, const TileGrid::Chunk& cells) {
+        slotOf[(size_t)cy * chunkCols + cx] = (int)planes.size();
+        planes.emplace_back();
+        ChunkPlanes& chunk = planes.back();
+        chunk.cx = cx;
+        chunk.cy = cy;
+        chunk.cells = &cells;
+        for (int r = 0; r < ROWS; r++) ClassifyRow(cells.cells + r * ROWS, chunk, r);
+    });
+
+    for (ChunkPlanes& chunk : planes) {
+        for (int r = 0; r < ROWS; r++) {
+            chunk.targets[r] = chunk.stored[r];
+            chunk.up[r] = chunk.right[r] = chunk.down[r] = chunk.left[r] = 0;
+        }
+        for (int t = 1; t < TILE_TYPE_COUNT; t++) {
+            if (!UsesAutoConnections((TileType)t)) continue;
+            uint64_t present = 0;
+            for (int r = 0; r < ROWS; r++) {
+                chunk.targets[r] |= chunk.types[t][r];
+                present |= chunk.types[t][r];
+            }
+            if (present) Connect(chunk, (TileType)t);
+        }
+        for (int r = 0; r < ROWS; r++) chunk.targets[r] &= chunk.anchors[r];
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Tile.h"
+#include "TileGrid.h"
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Recomputes every anchor's connections at once for whole-world updates.
+// Tile chunks are 64 cells wide, so each cell row of a chunk becomes one
+// 64-bit word per tile type, and the neighbour tests of
+// World::CalculateConnections turn into shifts, ORs and ANDs over whole rows.
+// Multi-cell footprints are folded into their edges first: a 2x2 road
+// connects up if either cell above its top edge does. Gives the same
+// connections as calling CalculateConnections on every anchor.
+class ConnectionPlanes {
+public:
+    static const int ROWS = TileGrid::CHUNK_SIZE;
+    static_assert(ROWS == 64, "one plane word per chunk row");
+
+private:
+    // Bit i of row r stands for the cell i columns and r rows into the chunk.
+    // Left uninitialized on creation; Build writes every plane it reads.
+    struct ChunkPlanes {
+        int cx, cy;
+        const TileGrid::Chunk* cells;
+        uint64_t types[TILE_TYPE_COUNT][ROWS];  // only for the classified types
+        uint64_t anchors[ROWS];  // non-empty anchor cells
+        uint64_t stored[ROWS];   // cells with connections set
+        // Anchors that may need rewriting: auto-connecting ones, and any
+        // other holding connections it shouldn't
+        uint64_t targets[ROWS];
+        // Connections of those anchors, one plane per direction
+        uint64_t up[ROWS];
+        uint64_t right[ROWS];
+        uint64_t down[ROWS];
+        uint64_t left[ROWS];
+
+        ChunkPlanes() {}
+    };
+
+    int rows = 0;
+    // Types that connect automatically or to one that does; the others get no plane
+    int classified[TILE_TYPE_COUNT];
+    int classifiedCount = 0;
+    int chunkRows = 0;
+    int chunkCols = 0;
+    std::vector<int> slotOf;  // chunk index -> planes index, -1 where unallocated
+    std::vector<ChunkPlanes> planes;
+
+    // Rows y .. y + count - 1 of chunk column cx into out, set where a cell has
+    // one of typeMask's types (bit per TileType); zero outside the grid and in
+    // unallocated chunks
+    void GatherRows(uint32_t typeMask, int cx, int y, int count, uint64_t* out) const;
+    // Sets the type, anchor and stored planes of one row of 64 cells
+    void ClassifyRow(const Tile* cells, ChunkPlanes& chunk, int r) const;
+    // Fills in the connections of one chunk's anchors of an auto-connecting type
+    void Connect(ChunkPlanes& chunk, TileType type);
+
+    static int LowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return (int)index;
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+public:
+    // Planes refer to the grid's chunks, so call Build again after editing it
+    void Build(const TileGrid& tiles);
+
+    // Calls visit(x, y, connections) for every anchor whose stored connections
+    // differ from the computed ones, chunk by chunk. Rewriting connections
+    // never frees a chunk, so visit may write them straight back to the grid.
+    template <typename Visit>
+    void ForEachChange(Visit&& visit) const {
+        for (const ChunkPlanes& chunk : planes) {
+            int x0 = chunk.cx * ROWS;
+            int y0 = chunk.cy * ROWS;
+            for (int r = 0; r < ROWS; r++) {
+                for (uint64_t bits = chunk.targets[r]; bits; bits &= bits - 1) {
+                    int i = LowestBit(bits);
+                    uint8_t connections = (uint8_t)(((chunk.up[r] >> i) & 1) * CONN_UP |
+                                                    ((chunk.right[r] >> i) & 1) * CONN_RIGHT |
+                                                    ((chunk.down[r] >> i) & 1) * CONN_DOWN |
+                                                    ((chunk.left[r] >> i) & 1) * CONN_LEFT);
+                    if (connections != chunk.cells->cells[r * ROWS + i].connections) {
+                        visit(x0 + i, y0 + r, connections);
+                    }
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,111 @@
+#include "DrawList.h"
+#include <algorithm>
+
+DrawList::Slot& DrawList::SlotOf(DrawKind kind, int id) {
+    std::vector<Slot>& table = slots[static_cast<int>(kind)];
+    if (id >= (int)table.size()) table.resize(id + 1);
+    return table[id];
+}
+
+const DrawList::Slot* DrawList::FindSlot(DrawKind kind, int id) const {
+    const std::vector<Slot>& table = slots[static_cast<int>(kind)];
+    if (id < 0 || id >= (int)table.size() || table[id].band < 0) return nullptr;
+    return &table[id];
+}
+
+void DrawList::Reindex(int band, int column, size_t from) {
+    std::vector<DrawItem>& items = bands[band][column];
+    for (size_t i = from; i < items.size(); i++) {
+        SlotOf(items[i].kind, items[i].id) = Slot{band, column, (int32_t)i};
+    }
+}
+
+const DrawItem* DrawList::FirstBelow(const std::vector<DrawItem>& items, float top) {
+    auto it = std::upper_bound(items.begin(), items.end(), top,
+                               [](float depth, const DrawItem& item) { return depth < item.depth; });
+    return items.data() + (it - items.begin());
+}
+
+// After any items already at the same depth, so ties keep placement order
+void DrawList::Insert(DrawKind kind, int id, int depth, Rectangle bounds) {
+    DrawItem item{depth, kind, id, bounds};
+    int band = BandOf(depth);
+    int column = ColumnOf((int)bounds.x);
+    if (band >= (int)bands.size()) bands.resize(band + 1);
+    if (column >= (int)bands[band].size()) bands[band].resize(column + 1);
+    std::vector<DrawItem>& items = bands[band][column];
+    auto it = std::upper_bound(items.begin(), items.end(), depth,
+                               [](int d, const DrawItem& other) { return d < other.depth; });
+    size_t index = it - items.begin();
+    items.insert(it, item);
+    Reindex(band, column, index);
+    count++;
+
+    maxAbove = std::max(maxAbove, depth - (int32_t)bounds.y);
+    maxBelow = std::max(maxBelow, (int32_t)(bounds.y + bounds.height) - depth);
+    maxWidth = std::max(maxWidth, (int32_t)bounds.width);
+}
+
+void DrawList::Remove(DrawKind kind, int id) {
+    const Slot* found = FindSlot(kind, id);
+    if (!found) return;
+    Slot slot = *found;
+    std::vector<DrawItem>& items = bands[slot.band][slot.column];
+    SlotOf(kind, id) = Slot{};
+    items.erase(items.begin() + slot.index);
+    Reindex(slot.band, slot.column, slot.index);
+    count--;
+}
+
+void DrawList::Renumber(DrawKind kind, int from, int to) {
+    const Slot* found = FindSlot(kind, from);
+    if (!found || from == to) return;
+    Slot slot = *found;
+    SlotOf(kind, from) = Slot{};
+    SlotOf(kind, to) = slot;
+    bands[slot.band][slot.column][slot.index].id = to;
+}
+
+void DrawList::Move(DrawKind kind, int id, int depth, Rectangle bounds) {
+    const Slot* found = FindSlot(kind, id);
+    if (!found) return;
+    Slot slot = *found;
+
+    if (BandOf(depth) != slot.band || ColumnOf((int)bounds.x) != slot.column) {
+        Remove(kind, id);
+        Insert(kind, id, depth, bounds);
+        return;
+    }
+
+    // Entities move a little per frame, so this steps past only a few neighbours
+    std::vector<DrawItem>& items = bands[slot.band][slot.column];
+    DrawItem item = items[slot.index];
+    item.depth = depth;
+    item.bounds = bounds;
+    int i = slot.index;
+    while (i > 0 && items[i - 1].depth > depth) {
+        items[i] = items[i - 1];
+        SlotOf(items[i].kind, items[i].id).index = i;
+        i--;
+    }
+    while (i + 1 < (int)items.size() && items[i + 1].depth < depth) {
+        items[i] = items[i + 1];
+        SlotOf(items[i].kind, items[i].id).index = i;
+        i++;
+    }
+    items[i] = item;
+    SlotOf(kind, id).index = i;
+
+    maxAbove = std::max(maxAbove, depth - (int32_t)bounds.y);
+    maxBelow = std::max(maxBelow, (int32_t)(bounds.y + bounds.height) - depth);
+    maxWidth = std::max(maxWidth, (int32_t)bounds.width);
+}
+
+void DrawList::Clear() {
+    bands.clear();
+    for (std::vector<Slot>& table : slots) table.clear();
+    count = 0;
+    maxAbove = 0;
+    maxBelow = 0;
+    maxWidth = 0;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Everything drawn above the ground layer; trains and minifigures join here
+enum class DrawKind : uint8_t {
+    Building
+};
+const int DRAW_KIND_COUNT = 1;
+
+struct DrawItem {
+    int32_t depth;      // world-pixel y where the item meets the ground
+    DrawKind kind;
+    int32_t id;         // index in the owner's array
+    Rectangle bounds;   // world-pixel rectangle used for culling
+};
+
+// Items standing on the ground, kept in back-to-front order across frames so
+// a frame only walks the part of the map on screen. Items live in buckets of
+// BAND_HEIGHT x COLUMN_WIDTH pixels that are each kept sorted, so placing or
+// removing shifts only its bucket, Move re-sorts by stepping past neighbours,
+// and a frame merges the few buckets of each band that the view crosses.
+class DrawList {
+private:
+    struct Slot {
+        int32_t band = -1;
+        int32_t column = -1;
+        int32_t index = -1;
+    };
+    // Read position in one bucket while merging a band
+    struct Cursor {
+        const DrawItem* next;
+        const DrawItem* end;
+    };
+
+    // bands[band][column], by depth and by the left edge of the bounds
+    std::vector<std::vector<std::vector<DrawItem>>> bands;
+    // Where each (kind, id) sits, band -1 if absent
+    std::vector<Slot> slots[DRAW_KIND_COUNT];
+    size_t count = 0;
+    // Furthest any item's bounds reach above and below its depth, and its widest bounds
+    int32_t maxAbove = 0;
+    int32_t maxBelow = 0;
+    int32_t maxWidth = 0;
+    // Visit's merge scratch, kept to avoid allocating per frame
+    mutable std::vector<Cursor> cursors;
+
+    Slot& SlotOf(DrawKind kind, int id);
+    const Slot* FindSlot(DrawKind kind, int id) const;
+    // Re-points slots of bucket items from index `from` on
+    void Reindex(int band, int column, size_t from);
+    // First item of a bucket deeper than top
+    static const DrawItem* FirstBelow(const std::vector<DrawItem>& items, float top);
+
+public:
+    static const int BAND_HEIGHT = 64;
+    static const int COLUMN_WIDTH = 512;
+
+    void Insert(DrawKind kind, int id, int depth, Rectangle bounds);
+    void Remove(DrawKind kind, int id);
+    // The owner moved item `from` to index `to` (e.g. swap-and-pop removal)
+    void Renumber(DrawKind kind, int from, int to);
+    // New depth and bounds for an item; re-inserted only if it changes bucket
+    void Move(DrawKind kind, int id, int depth, Rectangle bounds);
+    void Clear();
+
+    size_t Size() const { return count; }
+
+    // Calls draw(item) back to front for every item whose bounds overlap view;
+    // returns how many items in the view's buckets and depth range were checked.
+    // Items at the same depth draw left column first, then in insertion order.
+    template <typename Fn>
+    size_t Visit(Rectangle view, Fn&& draw) const {
+        float top = view.y - maxBelow;
+        float bottom = view.y + view.height + maxAbove;
+        float right = view.x + view.width;
+        if (bottom <= 0 || right <= 0 || bands.empty()) return 0;
+        int firstBand = BandOf((int)top);
+        int lastBand = BandOf((int)bottom);
+        if (lastBand >= (int)bands.size()) lastBand = (int)bands.size() - 1;
+        int firstColumn = ColumnOf((int)(view.x - maxWidth));
+        int lastColumn = ColumnOf((int)right);
+
+        size_t checked = 0;
+        for (int band = firstBand; band <= lastBand; band++) {
+            const std::vector<std::vector<DrawItem>>& columns = bands[band];
+            cursors.clear();
+            int endColumn = lastColumn < (int)columns.size() ? lastColumn : (int)columns.size() - 1;
+            for (int column = firstColumn; column <= endColumn; column++) {
+                const std::vector<DrawItem>& items = columns[column];
+                const DrawItem* next = FirstBelow(items, top);
+                const DrawItem* end = items.data() + items.size();
+                if (next != end && next->depth < bottom) cursors.push_back({ next, end });
+            }
+
+            // A band holds at most BAND_HEIGHT distinct depths, so the buckets
+            // are merged a whole depth at a time, left to right
+            while (true) {
+                int32_t depth = INT32_MAX;
+                for (const Cursor& cursor : cursors) {
+                    if (cursor.next != cursor.end && cursor.next->depth < depth) depth = cursor.next->depth;
+                }
+                if (depth >= bottom) break;
+                for (Cursor& cursor : cursors) {
+                    for (; cursor.next != cursor.end && cursor.next->depth == depth; cursor.next++) {
+                        checked++;
+                        const Rectangle& b = cursor.next->bounds;
+                        if (b.x >= right || b.x + b.width <= view.x ||
+                            b.y >= view.y + view.height || b.y + b.height <= view.y) continue;
+                        draw(*cursor.next);
+                    }
+                }
+            }
+        }
+        return checked;
+    }
+
+    static int BandOf(int depth) { return depth < 0 ? 0 : depth / BAND_HEIGHT; }
+    static int ColumnOf(int x) { return x < 0 ? 0 : x / COLUMN_WIDTH; }
+};
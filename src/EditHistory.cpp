@@ -0,0 +1,134 @@
+#include "EditHistory.h"
+#include "World.h"
+
+static uint64_t CellKey(int x, int y) {
+    return ((uint64_t)(uint32_t)y << 32) | (uint32_t)x;
+}
+
+size_t EditHistory::Step::Bytes() const {
+    return sizeof(Step) + cells.capacity() * sizeof(CellDelta) + buildings.capacity() * sizeof(BuildingDelta);
+}
+
+void EditHistory::BeginStep() {
+    if (recording) return;
+    recording = true;
+    openStep = Step{};
+    openCells.clear();
+}
+
+void EditHistory::EndStep(const World& world) {
+    if (!recording) return;
+    recording = false;
+    openCells.clear();
+    if (openStep.cells.empty() && openStep.buildings.empty()) return;
+
+    for (CellDelta& delta : openStep.cells) {
+        delta.after = world.GetTile(delta.x, delta.y);
+    }
+    openStep.cells.shrink_to_fit();
+    openStep.buildings.shrink_to_fit();
+
+    // A new step replaces anything that could have been redone
+    while (steps.size() > cursor) {
+        bytesUsed -= steps.back().Bytes();
+        steps.pop_back();
+    }
+    bytesUsed += openStep.Bytes();
+    steps.push_back(std::move(openStep));
+    cursor = steps.size();
+    openStep = Step{};
+    TrimToBudget();
+}
+
+void EditHistory::RecordTileChange(int x, int y, const Tile& before) {
+    if (!recording || applying) return;
+    // Only the first write of a cell in a step holds its before state
+    auto inserted = openCells.emplace(CellKey(x, y), openStep.cells.size());
+    if (inserted.second) {
+        openStep.cells.push_back({x, y, before, Tile{}});
+    }
+}
+
+void EditHistory::RecordBuilding(bool placed, BuildingType type, int x, int y) {
+    if (!recording || applying) return;
+    openStep.buildings.push_back({placed, type, x, y});
+}
+
+// Every multi-tile with a changed cell was written as a whole within the step,
+// so clearing the current pieces at their anchors and re-placing the target
+// pieces at theirs touches exactly the step's cells.
+void EditHistory::Apply(const Step& step, bool undo, World& world) {
+    applying = true;
+
+    if (undo) {
+        for (auto it = step.buildings.rbegin(); it != step.buildings.rend(); ++it) {
+            if (it->placed) world.RemoveBuilding(it->x, it->y);
+            else world.PlaceBuilding(it->type, it->x, it->y);
+        }
+    }
+
+    for (const CellDelta& delta : step.cells) {
+        const Tile& current = undo ? delta.after : delta.before;
+        if (current.type != TileType::Empty && current.IsAnchor()) {
+            world.SetTile(delta.x, delta.y, TileType::Empty);
+        }
+    }
+    for (const CellDelta& delta : step.cells) {
+        const Tile& target = undo ? delta.before : delta.after;
+        if (target.type != TileType::Empty && target.IsAnchor()) {
+            world.SetTile(delta.x, delta.y, target.type, QuarterTurnsToDegrees(target.rotation));
+        }
+    }
+
+    if (!undo) {
+        for (const BuildingDelta& delta : step.buildings) {
+            if (delta.placed) world.PlaceBuilding(delta.type, delta.x, delta.y);
+            else world.RemoveBuilding(delta.x, delta.y);
+        }
+    }
+
+    applying = false;
+}
+
+bool EditHistory::Undo(World& world) {
+    if (recording || !CanUndo()) return false;
+    cursor--;
+    Apply(steps[cursor], true, world);
+    return true;
+}
+
+bool EditHistory::Redo(World& world) {
+    if (recording || !CanRedo()) return false;
+    Apply(steps[cursor], false, world);
+    cursor++;
+    return true;
+}
+
+void EditHistory::Clear() {
+    steps.clear();
+    cursor = 0;
+    bytesUsed = 0;
+    recording = false;
+    openStep = Step{};
+    openCells.clear();
+}
+
+void EditHistory::SetByteBudget(size_t budget) {
+    byteBudget = budget;
+    TrimToBudget();
+}
+
+// Each step only applies next to its neighbours, so history is cut from the
+// ends: the oldest undo steps first, then the furthest redo steps
+void EditHistory::TrimToBudget() {
+    while (bytesUsed > byteBudget && !steps.empty()) {
+        if (cursor > 0) {
+            bytesUsed -= steps.front().Bytes();
+            steps.pop_front();
+            cursor--;
+        } else {
+            bytesUsed -= steps.back().Bytes();
+            steps.pop_back();
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Tile.h"
+#include "Building.h"
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+class World;
+
+// Undo/redo as per-step deltas: each step keeps the before and after state of
+// only the cells and buildings it touched, so undo and redo cost O(cells
+// touched) and replay through SetTile/PlaceBuilding (graphs and journal stay
+// in sync). Oldest steps are dropped once the history exceeds its byte budget.
+class EditHistory {
+private:
+    struct CellDelta {
+        int32_t x;
+        int32_t y;
+        Tile before;
+        Tile after;
+    };
+
+    struct BuildingDelta {
+        bool placed;
+        BuildingType type;
+        int32_t x;
+        int32_t y;
+    };
+
+    struct Step {
+        std::vector<CellDelta> cells;
+        std::vector<BuildingDelta> buildings;
+        size_t Bytes() const;
+    };
+
+    // steps[0, cursor) can be undone, steps[cursor, end) redone
+    std::deque<Step> steps;
+    size_t cursor = 0;
+    size_t bytesUsed = 0;
+    size_t byteBudget;
+
+    // Step being recorded, with each touched cell's slot in it
+    Step openStep;
+    std::unordered_map<uint64_t, size_t> openCells;
+    bool recording = false;
+    bool applying = false;
+
+    void Apply(const Step& step, bool undo, World& world);
+    void TrimToBudget();
+
+public:
+    static const size_t DEFAULT_BYTE_BUDGET = 4 * 1024 * 1024;
+
+    explicit EditHistory(size_t byteBudget = DEFAULT_BYTE_BUDGET) : byteBudget(byteBudget) {}
+
+    // Edits between BeginStep and EndStep (e.g. one drag stroke) undo as one step
+    void BeginStep();
+    void EndStep(const World& world);
+
+    bool Undo(World& world);
+    bool Redo(World& world);
+    bool CanUndo() const { return cursor > 0; }
+    bool CanRedo() const { return cursor < steps.size(); }
+
+    // Forget everything, e.g. after loading a different world
+    void Clear();
+    void SetByteBudget(size_t budget);
+    size_t GetBytesUsed() const { return bytesUsed; }
+    size_t GetStepCount() const { return steps.size(); }
+
+    // Called by World before a cell is overwritten, and after building changes
+    void RecordTileChange(int x, int y, const Tile& before);
+    void RecordBuilding(bool placed, BuildingType type, int x, int y);
+};
@@ -0,0 +1,153 @@
+#include "EditJournal.h"
+#include "World.h"
+#include "MappedFile.h"
+#include <random>
+#include <chrono>
+#include <cstring>
+
+// Journal layout: JournalHeader, then JournalRecord entries until end of file
+static const char JOURNAL_MAGIC[4] = { 'L', 'J', 'N', 'L' };
+static const uint32_t JOURNAL_VERSION = 1;
+
+struct JournalHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t lineage;
+    uint64_t firstSeq;
+};
+
+static_assert(sizeof(JournalHeader) == 24, "JournalHeader layout");
+
+// FNV-1a over the record fields and its sequence number
+static uint32_t RecordCheck(const JournalRecord& record, uint64_t seq) {
+    unsigned char bytes[12 + sizeof(seq)];
+    memcpy(bytes, &record, 12);
+    memcpy(bytes + 12, &seq, sizeof(seq));
+    uint32_t hash = 2166136261u;
+    for (unsigned char b : bytes) {
+        hash = (hash ^ b) * 16777619u;
+    }
+    return hash;
+}
+
+bool EditJournal::Create(const std::string& path, uint64_t newLineage, uint64_t newFirstSeq,
+                         std::vector<JournalRecord> carried) {
+    Close();
+
+    JournalHeader header = {
+        {JOURNAL_MAGIC[0], JOURNAL_MAGIC[1], JOURNAL_MAGIC[2], JOURNAL_MAGIC[3]},
+        JOURNAL_VERSION, newLineage, newFirstSeq
+    };
+    std::vector<unsigned char> contents(sizeof(header) + carried.size() * sizeof(JournalRecord));
+    memcpy(contents.data(), &header, sizeof(header));
+    if (!carried.empty()) {
+        memcpy(contents.data() + sizeof(header), carried.data(), carried.size() * sizeof(JournalRecord));
+    }
+    if (!WriteFileAtomic(path, contents.data(), contents.size())) return false;
+
+    file = fopen(path.c_str(), "ab");
+    if (!file) return false;
+
+    filepath = path;
+    lineage = newLineage;
+    firstSeq = newFirstSeq;
+    records = std::move(carried);
+    flushedCount = records.size();
+    return true;
+}
+
+void EditJournal::Close() {
+    if (!file) return;
+    Sync();
+    fclose(file);
+    file = nullptr;
+}
+
+void EditJournal::Append(JournalOp op, uint8_t type, uint8_t rotation, int x, int y) {
+    if (!file) return;
+    JournalRecord record = { op, type, rotation, 0, x, y, 0 };
+    record.check = RecordCheck(record, GetNextSeq());
+    records.push_back(record);
+}
+
+void EditJournal::RecordSetTile(int x, int y, TileType type, uint8_t quarterTurns) {
+    Append(JournalOp::SetTile, (uint8_t)type, quarterTurns, x, y);
+}
+
+void EditJournal::RecordPlaceBuilding(BuildingType type, int x, int y) {
+    Append(JournalOp::PlaceBuilding, (uint8_t)type, 0, x, y);
+}
+
+void EditJournal::RecordRemoveBuilding(int x, int y) {
+    Append(JournalOp::RemoveBuilding, 0, 0, x, y);
+}
+
+bool EditJournal::Flush() {
+    if (!file) return false;
+    if (!HasUnflushed()) return true;
+
+    size_t count = records.size() - flushedCount;
+    bool ok = fwrite(records.data() + flushedCount, sizeof(JournalRecord), count, file) == count;
+    ok = fflush(file) == 0 && ok;
+    if (ok) flushedCount = records.size();
+    return ok;
+}
+
+bool EditJournal::Sync() {
+    return Flush() && SyncFile(file);
+}
+
+bool EditJournal::Rebase(uint64_t seq) {
+    if (!file || seq < firstSeq || seq > GetNextSeq()) return false;
+    if (seq == firstSeq) return true;
+
+    std::vector<JournalRecord> tail(records.begin() + (size_t)(seq - firstSeq), records.end());
+    return Create(filepath, lineage, seq, std::move(tail));
+}
+
+uint64_t EditJournal::NewLineage() {
+    std::random_device device;
+    uint64_t id = ((uint64_t)device() << 32) ^ device() ^
+                  (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    return id != 0 ? id : 1;
+}
+
+int EditJournal::Replay(const std::string& path, uint64_t lineage, uint64_t fromSeq,
+                        World& world, std::vector<JournalRecord>& applied) {
+    applied.clear();
+
+    MappedFile journal;
+    if (!journal.Open(path)) return 0;
+
+    JournalHeader header;
+    if (journal.Size() < sizeof(header)) return -1;
+    memcpy(&header, journal.Data(), sizeof(header));
+    if (memcmp(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 || header.version != JOURNAL_VERSION) return -1;
+    if (header.lineage != lineage || header.firstSeq > fromSeq) return -1;
+
+    size_t count = (journal.Size() - sizeof(header)) / sizeof(JournalRecord);
+    for (size_t i = 0; i < count; i++) {
+        JournalRecord record;
+        memcpy(&record, journal.Data() + sizeof(header) + i * sizeof(record), sizeof(record));
+        uint64_t seq = header.firstSeq + i;
+        if (record.check != RecordCheck(record, seq)) break;
+        if (seq < fromSeq) continue;
+
+        switch (record.op) {
+            case JournalOp::SetTile:
+                if (record.type > (uint8_t)TileType::TrackCorner) return (int)applied.size();
+                world.SetTile(record.x, record.y, (TileType)record.type, QuarterTurnsToDegrees(record.rotation));
+                break;
+            case JournalOp::PlaceBuilding:
+                world.PlaceBuilding((BuildingType)record.type, record.x, record.y);
+                break;
+            case JournalOp::RemoveBuilding:
+                world.RemoveBuilding(record.x, record.y);
+                break;
+            default:
+                return (int)applied.size();
+        }
+        applied.push_back(record);
+    }
+    return (int)applied.size();
+}
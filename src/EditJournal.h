@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Tile.h"
+#include "Building.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+class World;
+
+enum class JournalOp : uint8_t {
+    SetTile = 1,
+    PlaceBuilding,
+    RemoveBuilding
+};
+
+// One world edit as stored on disk (16 bytes)
+struct JournalRecord {
+    JournalOp op;
+    uint8_t type;       // TileType or BuildingType
+    uint8_t rotation;   // quarter turns, SetTile only
+    uint8_t reserved;
+    int32_t x;
+    int32_t y;
+    uint32_t check;     // hash of the fields above and the record's sequence number
+};
+
+static_assert(sizeof(JournalRecord) == 16, "JournalRecord layout");
+
+// Append-only log of the edits made since the last snapshot. Every edit has a
+// sequence number; a snapshot stores the lineage (which world history it
+// belongs to) and the first sequence number it does not contain, so loading
+// replays exactly the journal records after it. Records are buffered in
+// memory, written by Flush and made durable by Sync. A record torn by a
+// crash fails its check and ends the replay.
+class EditJournal {
+private:
+    std::string filepath;
+    FILE* file = nullptr;
+    uint64_t lineage = 0;
+    uint64_t firstSeq = 0;
+    // Every record since firstSeq; the first flushedCount are already in the file
+    std::vector<JournalRecord> records;
+    size_t flushedCount = 0;
+
+    void Append(JournalOp op, uint8_t type, uint8_t rotation, int x, int y);
+
+public:
+    EditJournal() = default;
+    ~EditJournal() { Close(); }
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    // Atomically replaces the journal file with one starting at firstSeq that
+    // holds the given records, then keeps it open for appending
+    bool Create(const std::string& path, uint64_t lineage, uint64_t firstSeq,
+                std::vector<JournalRecord> carried = {});
+    // Flushes, syncs and closes the file
+    void Close();
+    bool IsOpen() const { return file != nullptr; }
+
+    void RecordSetTile(int x, int y, TileType type, uint8_t quarterTurns);
+    void RecordPlaceBuilding(BuildingType type, int x, int y);
+    void RecordRemoveBuilding(int x, int y);
+
+    // Writes buffered records to the file (cheap, no disk sync)
+    bool Flush();
+    // Flush plus fsync
+    bool Sync();
+    // Drops the records before seq once a snapshot containing them is on disk
+    bool Rebase(uint64_t seq);
+
+    uint64_t GetLineage() const { return lineage; }
+    uint64_t GetNextSeq() const { return firstSeq + records.size(); }
+    size_t GetRecordCount() const { return records.size(); }
+    bool HasUnflushed() const { return flushedCount < records.size(); }
+
+    // Fresh random lineage id for a new world history (never 0)
+    static uint64_t NewLineage();
+
+    // Applies the records of the journal at path from fromSeq on. Returns the number
+    // applied (0 if there is no journal) and the applied records, or -1 if the journal
+    // belongs to another lineage or starts after fromSeq.
+    static int Replay(const std::string& path, uint64_t lineage, uint64_t fromSeq,
+                      World& world, std::vector<JournalRecord>& applied);
+};
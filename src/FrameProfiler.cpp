@@ -0,0 +1,134 @@
+#include "FrameProfiler.h"
+#include "MappedFile.h"
+#include <cstdio>
+
+const char* GetProfileStageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::Camera:        return "Camera";
+        case ProfileStage::Input:         return "Input";
+        case ProfileStage::PathGraph:     return "PathGraph";
+        case ProfileStage::Simulation:    return "Simulation";
+        case ProfileStage::Save:          return "Save";
+        case ProfileStage::PrepareRender: return "PrepareRender";
+        case ProfileStage::RenderTiles:   return "RenderTiles";
+        case ProfileStage::RenderObjects: return "RenderObjects";
+        case ProfileStage::Debug:         return "Debug";
+        case ProfileStage::UI:            return "UI";
+        case ProfileStage::Present:       return "Present";
+        default:                          return "Unknown";
+    }
+}
+
+#if LOCO_PROFILE
+
+FrameProfiler FrameProfiler::instance;
+
+FrameProfiler::FrameProfiler() : origin(Clock::now()), frames(FRAME_COUNT) {}
+
+void FrameProfiler::BeginFrame() {
+    frameStart = Clock::now();
+    Frame& frame = Current();
+    frame.start = std::chrono::duration_cast<std::chrono::microseconds>(frameStart - origin).count();
+    frame.duration = 0.0;
+    std::fill(std::begin(frame.stageTotal), std::end(frame.stageTotal), 0.0);
+    frame.eventCount = 0;
+    depth = 0;
+    overflow = 0;
+    inFrame = true;
+}
+
+void FrameProfiler::EndFrame() {
+    if (!inFrame) return;
+    Current().duration = Micros(frameStart, Clock::now());
+    inFrame = false;
+    frameCount++;
+}
+
+bool FrameProfiler::Push(ProfileStage stage) {
+    if (depth == MAX_DEPTH) {
+        overflow++;
+        return true;
+    }
+    stack[depth++] = Open{ stage, Clock::now() };
+    return true;
+}
+
+void FrameProfiler::End() {
+    if (overflow > 0) {
+        overflow--;
+        return;
+    }
+    if (!inFrame || depth == 0) return;
+
+    Clock::time_point now = Clock::now();
+    const Open& open = stack[--depth];
+    double duration = Micros(open.start, now);
+    Frame& frame = Current();
+    frame.stageTotal[static_cast<int>(open.stage)] += duration;
+    if (frame.eventCount < MAX_EVENTS) {
+        frame.events[frame.eventCount++] = Event{ open.stage, (uint8_t)depth, Micros(frameStart, open.start), duration };
+    }
+}
+
+FrameProfiler::Stats FrameProfiler::Summarize(std::vector<double>& samples) const {
+    Stats stats;
+    stats.frames = (int)samples.size();
+    if (samples.empty()) return stats;
+
+    double sum = 0.0;
+    stats.min = samples[0];
+    for (double sample : samples) {
+        stats.min = std::min(stats.min, sample);
+        sum += sample;
+    }
+    stats.avg = sum / samples.size();
+    size_t index = std::min(samples.size() - 1, samples.size() * 99 / 100);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    stats.p99 = samples[index];
+    return stats;
+}
+
+FrameProfiler::Stats FrameProfiler::GetStageStats(ProfileStage stage) const {
+    std::vector<double> samples;
+    for (int age = 0; age < GetFrameCount(); age++) {
+        double total = GetFrame(age).stageTotal[static_cast<int>(stage)];
+        if (total > 0.0) samples.push_back(total);
+    }
+    return Summarize(samples);
+}
+
+FrameProfiler::Stats FrameProfiler::GetFrameStats() const {
+    std::vector<double> samples;
+    for (int age = 0; age < GetFrameCount(); age++) samples.push_back(GetFrame(age).duration);
+    return Summarize(samples);
+}
+
+bool FrameProfiler::WriteTrace(const std::string& path) const {
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    char line[160];
+    bool first = true;
+    auto add = [&](const char* name, double ts, double dur) {
+        snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f}",
+                 first ? "" : ",\n", name, ts, dur);
+        json += line;
+        first = false;
+    };
+
+    // Oldest first; parents before children at equal timestamps so viewers nest them
+    for (int age = GetFrameCount() - 1; age >= 0; age--) {
+        const Frame& frame = GetFrame(age);
+        add("Frame", (double)frame.start, frame.duration);
+        std::vector<const Event*> events;
+        for (int i = 0; i < frame.eventCount; i++) events.push_back(&frame.events[i]);
+        std::stable_sort(events.begin(), events.end(), [](const Event* a, const Event* b) {
+            return a->start != b->start ? a->start < b->start : a->depth < b->depth;
+        });
+        for (const Event* event : events) {
+            add(GetProfileStageName(event->stage), (double)frame.start + event->start, event->duration);
+        }
+    }
+    json += "\n]}\n";
+    return WriteFileAtomic(path, json.data(), json.size());
+}
+
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Build with LOCO_PROFILE=0 to compile every timer out
+#ifndef LOCO_PROFILE
+#define LOCO_PROFILE 1
+#endif
+
+// Parts of a frame that get their own timer. Stages may nest (world edits
+// patch the path graph inside Input); each stage's time includes its children.
+enum class ProfileStage : uint8_t {
+    Camera,
+    Input,
+    PathGraph,
+    Simulation,
+    Save,
+    PrepareRender,
+    RenderTiles,
+    RenderObjects,
+    Debug,
+    UI,
+    Present
+};
+const int PROFILE_STAGE_COUNT = 11;
+
+const char* GetProfileStageName(ProfileStage stage);
+
+#if LOCO_PROFILE
+
+// Per-stage timings of the last FRAME_COUNT frames in a ring buffer. Timers
+// only record between BeginFrame and EndFrame, so core code timed here costs a
+// flag check when it runs outside the game loop (tools, loading).
+class FrameProfiler {
+public:
+    static const int FRAME_COUNT = 300;
+    // Scopes kept per frame for the trace; later ones still count in the totals
+    static const int MAX_EVENTS = 64;
+    static const int MAX_DEPTH = 8;
+
+    // Times in microseconds, events relative to their frame's start
+    struct Event {
+        ProfileStage stage;
+        uint8_t depth;
+        double start;
+        double duration;
+    };
+
+    struct Frame {
+        int64_t start;  // since the profiler was created, whole microseconds
+        double duration;
+        double stageTotal[PROFILE_STAGE_COUNT];
+        int eventCount;
+        Event events[MAX_EVENTS];
+    };
+
+    struct Stats {
+        double min = 0.0;
+        double avg = 0.0;
+        double p99 = 0.0;
+        int frames = 0;  // frames the stage ran in
+    };
+
+    class Scope {
+    private:
+        bool active;
+
+    public:
+        explicit Scope(ProfileStage stage) : active(Get().Begin(stage)) {}
+        ~Scope() { if (active) Get().End(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Open {
+        ProfileStage stage;
+        Clock::time_point start;
+    };
+
+    static FrameProfiler instance;
+
+    Clock::time_point origin;
+    Clock::time_point frameStart;
+    std::vector<Frame> frames;
+    uint64_t frameCount = 0;  // frames completed
+    bool inFrame = false;
+    Open stack[MAX_DEPTH];
+    int depth = 0;
+    int overflow = 0;  // scopes opened past MAX_DEPTH, ignored
+
+    Frame& Current() { return frames[frameCount % FRAME_COUNT]; }
+    // Double keeps sub-microsecond precision for stage times; frame starts
+    // are counted in integer microseconds so they stay exact in long sessions
+    double Micros(Clock::time_point from, Clock::time_point to) const {
+        return std::chrono::duration<double, std::micro>(to - from).count();
+    }
+    bool Push(ProfileStage stage);
+    Stats Summarize(std::vector<double>& samples) const;
+
+public:
+    FrameProfiler();
+    static FrameProfiler& Get() { return instance; }
+
+    void BeginFrame();
+    void EndFrame();
+    // Begin returns false (and must not be matched by End) outside a frame
+    bool Begin(ProfileStage stage) { return inFrame && Push(stage); }
+    void End();
+
+    // Completed frames held, and the one 'age' frames back (0 = the latest)
+    int GetFrameCount() const { return (int)std::min<uint64_t>(frameCount, FRAME_COUNT); }
+    const Frame& GetFrame(int age) const { return frames[(frameCount - 1 - age) % FRAME_COUNT]; }
+    Stats GetStageStats(ProfileStage stage) const;
+    Stats GetFrameStats() const;
+
+    // Chrome trace JSON (chrome://tracing, Perfetto) of the frames held
+    bool WriteTrace(const std::string& path) const;
+};
+
+// Bracket one pass of the game loop
+#define PROFILE_FRAME_BEGIN() FrameProfiler::Get().BeginFrame()
+#define PROFILE_FRAME_END() FrameProfiler::Get().EndFrame()
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// Times the rest of the enclosing block
+#define PROFILE_SCOPE(stage) FrameProfiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(ProfileStage::stage)
+// Times straight-line code that doesn't sit in its own block; only use inside a frame
+#define PROFILE_BEGIN(stage) FrameProfiler::Get().Begin(ProfileStage::stage)
+#define PROFILE_END() FrameProfiler::Get().End()
+
+#else
+
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_SCOPE(stage) ((void)0)
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END() ((void)0)
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdio>
+
+// Read-only memory mapping of a whole file. Kept free of raylib so the
+// platform headers it needs (windows.h) don't clash with raylib names.
+class MappedFile {
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails for missing or empty files
+    bool Open(const std::string& filepath);
+    void Close();
+
+    const unsigned char* Data() const { return data; }
+    size_t Size() const { return size; }
+};
+
+// Flushes stdio buffers and forces the file's contents to disk
+bool SyncFile(FILE* file);
+
+// Writes to a sibling temp file, syncs it and renames it over the target, so a
+// crash mid-write leaves the previous contents intact
+bool WriteFileAtomic(const std::string& filepath, const void* data, size_t size);
@@ -1,35 +1,37 @@
 #include "PathGraph.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
 
 // 4-directional offsets: right, down, left, up
 static const int DX[] = { 1, 0, -1, 0 };
 static const int DY[] = { 0, 1, 0, -1 };
 
-bool PathGraph::IsPath(const std::vector<std::vector<Tile>>& tiles, int x, int y, int rows, int cols) const {
-    if (x < 0 || x >= cols || y < 0 || y >= rows) return false;
-    return tiles[y][x].type == TileType::Path;
+bool PathGraph::IsPath(const TileGrid& tiles, int x, int y) const {
+    return tiles.TypeAt(x, y) == TileType::Path;
 }
 
-int PathGraph::CountNeighbors(const std::vector<std::vector<Tile>>& tiles, int x, int y, int rows, int cols) const {
+int PathGraph::CountNeighbors(const TileGrid& tiles, int x, int y) const {
     int count = 0;
     for (int d = 0; d < 4; d++) {
-        if (IsPath(tiles, x + DX[d], y + DY[d], rows, cols)) count++;
+        if (IsPath(tiles, x + DX[d], y + DY[d])) count++;
     }
     return count;
 }
 
-bool PathGraph::IsNode(const std::vector<std::vector<Tile>>& tiles, int x, int y, int rows, int cols) const {
-    if (!IsPath(tiles, x, y, rows, cols)) return false;
+bool PathGraph::IsNode(const TileGrid& tiles, int x, int y) const {
+    if (!IsPath(tiles, x, y)) return false;
 
-    int neighbors = CountNeighbors(tiles, x, y, rows, cols);
+    int neighbors = CountNeighbors(tiles, x, y);
 
     // Endpoint (dead end) or intersection (3+ neighbors)
     if (neighbors != 2) return true;
 
     // 2 neighbors: check if they form a corner (not a straight line)
-    bool hasLeft  = IsPath(tiles, x - 1, y, rows, cols);
-    bool hasRight = IsPath(tiles, x + 1, y, rows, cols);
-    bool hasUp    = IsPath(tiles, x, y - 1, rows, cols);
-    bool hasDown  = IsPath(tiles, x, y + 1, rows, cols);
+    bool hasLeft  = IsPath(tiles, x - 1, y);
+    bool hasRight = IsPath(tiles, x + 1, y);
+    bool hasUp    = IsPath(tiles, x, y - 1);
+    bool hasDown  = IsPath(tiles, x, y + 1);
 
     // Straight line = opposite sides connected
     if ((hasLeft && hasRight) || (hasUp && hasDown)) return false;
@@ -38,102 +40,485 @@ bool PathGraph::IsNode(const std::vector<std::vector<Tile>>& tiles, int x, int y
     return true;
 }
 
-void PathGraph::Build(const std::vector<std::vector<Tile>>& tiles, int rows, int cols) {
+// Runs tasks [0, count) on the pool, or inline without one
+static void RunTasks(WorkerPool* pool, int count, const std::function<void(int)>& task) {
+    if (pool) {
+        pool->Run(count, task);
+    } else {
+        for (int i = 0; i < count; i++) task(i);
+    }
+}
+
+void PathGraph::Build(const TileGrid& tiles, WorkerPool* pool) {
+    int rows = tiles.GetRows();
+    int cols = tiles.GetCols();
+    InvalidateCache();
     nodes.clear();
-    posToNode.clear();
-    maxCols = cols;
-
-    // Pass 1: Find all nodes
-    for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            if (IsNode(tiles, x, y, rows, cols)) {
-                int idx = (int)nodes.size();
-                posToNode[PosKey(x, y)] = idx;
-                nodes.push_back(PathNode{x, y, {}});
+    edgeTargets.clear();
+    edgeCosts.clear();
+    staleEdges = 0;
+    nodeAt.Reset(rows, cols, -1);
+
+    // Pass 1: Find all nodes, one band of chunk rows per task. Paths only
+    // exist in allocated tile chunks. Bands are joined in order, so node
+    // numbering is the same however many threads ran.
+    std::vector<std::vector<PathNode>> bandNodes(tiles.GetChunkRows());
+    RunTasks(pool, (int)bandNodes.size(), [&](int cy) {
+        for (int cx = 0; cx < tiles.GetChunkCols(); cx++) {
+            const TileGrid::Chunk* chunk = tiles.GetChunk(cx, cy);
+            if (!chunk) continue;
+            int originX = cx * TileGrid::CHUNK_SIZE;
+            int originY = cy * TileGrid::CHUNK_SIZE;
+            for (int i = 0; i < TileGrid::CHUNK_CELLS; i++) {
+                if (chunk->cells[i].type != TileType::Path) continue;
+                int x = originX + (i & TileGrid::CHUNK_MASK);
+                int y = originY + (i >> TileGrid::CHUNK_SHIFT);
+                if (IsNode(tiles, x, y)) bandNodes[cy].push_back(PathNode{x, y, 0, 0});
             }
         }
+    });
+    for (const std::vector<PathNode>& band : bandNodes) {
+        for (const PathNode& node : band) {
+            nodeAt.Set(node.x, node.y, (int)nodes.size());
+            nodes.push_back(node);
+        }
     }
 
-    // Pass 2: Walk from each node in each direction to find edges
-    for (int i = 0; i < (int)nodes.size(); i++) {
-        int nx = nodes[i].x;
-        int ny = nodes[i].y;
-
-        for (int d = 0; d < 4; d++) {
-            int cx = nx + DX[d];
-            int cy = ny + DY[d];
-
-            if (!IsPath(tiles, cx, cy, rows, cols)) continue;
-
-            // Walk in this direction until we hit another node
-            int cost = 1;
-            while (true) {
-                auto it = posToNode.find(PosKey(cx, cy));
-                if (it != posToNode.end()) {
-                    // Found a node - create edge
-                    nodes[i].edges.push_back({it->second, cost + 1});
-                    break;
-                }
+    // Pass 2: Walk from each node in each direction to find edges. Walks only
+    // read the tiles and node index, so blocks of nodes collect their edges in
+    // parallel; appending the blocks in node order gives the serial CSR arrays.
+    struct EdgeBlock {
+        std::vector<int> targets;
+        std::vector<int> costs;
+    };
+    int blockCount = ((int)nodes.size() + BUILD_NODES_PER_TASK - 1) / BUILD_NODES_PER_TASK;
+    std::vector<EdgeBlock> blocks(blockCount);
+    RunTasks(pool, blockCount, [&](int b) {
+        EdgeBlock& block = blocks[b];
+        int end = std::min((b + 1) * BUILD_NODES_PER_TASK, (int)nodes.size());
+        for (int i = b * BUILD_NODES_PER_TASK; i < end; i++) {
+            int targets[4], costs[4];
+            int count = WalkEdges(tiles, nodes[i].x, nodes[i].y, targets, costs);
+            nodes[i].edgeCount = count;
+            block.targets.insert(block.targets.end(), targets, targets + count);
+            block.costs.insert(block.costs.end(), costs, costs + count);
+        }
+    });
 
-                // Continue walking - find the next path tile that continues the direction
-                // From a straight tile, there are exactly 2 neighbors; go to the one we didn't come from
-                int prevX = (cost == 1) ? nx : cx - DX[d];
-                int prevY = (cost == 1) ? ny : cy - DY[d];
-
-                bool found = false;
-                for (int nd = 0; nd < 4; nd++) {
-                    int nextX = cx + DX[nd];
-                    int nextY = cy + DY[nd];
-                    if (nextX == prevX && nextY == prevY) continue;
-                    if (IsPath(tiles, nextX, nextY, rows, cols)) {
-                        // Update direction for next iteration
-                        prevX = cx;
-                        prevY = cy;
-                        cx = nextX;
-                        cy = nextY;
-                        cost++;
-                        found = true;
-                        break;
-                    }
-                }
+    size_t edgeCount = 0;
+    for (const EdgeBlock& block : blocks) edgeCount += block.targets.size();
+    edgeTargets.reserve(edgeCount);
+    edgeCosts.reserve(edgeCount);
+    for (int b = 0; b < blockCount; b++) {
+        int end = std::min((b + 1) * BUILD_NODES_PER_TASK, (int)nodes.size());
+        int first = (int)edgeTargets.size();
+        for (int i = b * BUILD_NODES_PER_TASK; i < end; i++) {
+            nodes[i].firstEdge = first;
+            first += nodes[i].edgeCount;
+        }
+        edgeTargets.insert(edgeTargets.end(), blocks[b].targets.begin(), blocks[b].targets.end());
+        edgeCosts.insert(edgeCosts.end(), blocks[b].costs.begin(), blocks[b].costs.end());
+    }
+}
+
+bool PathGraph::Restore(const TileGrid& tiles, std::vector<PathNode> savedNodes,
+                        std::vector<int> targets, std::vector<int> costs) {
+    int rows = tiles.GetRows();
+    int cols = tiles.GetCols();
+    InvalidateCache();
+    nodes.clear();
+    edgeTargets.clear();
+    edgeCosts.clear();
+    staleEdges = 0;
+    nodeAt.Reset(rows, cols, -1);
 
-                if (!found) break;
+    if (targets.size() != costs.size()) return false;
+
+    // Nodes must sit on node cells of the tiles, with an edge per path neighbour
+    int firstEdge = 0;
+    for (PathNode& node : savedNodes) {
+        if (node.x < 0 || node.x >= cols || node.y < 0 || node.y >= rows) return false;
+        if (!IsNode(tiles, node.x, node.y) || node.edgeCount != CountNeighbors(tiles, node.x, node.y)) return false;
+        if (nodeAt.At(node.x, node.y) >= 0) return false;
+        node.firstEdge = firstEdge;
+        firstEdge += node.edgeCount;
+        nodeAt.Set(node.x, node.y, (int)(&node - savedNodes.data()));
+    }
+    if (firstEdge != (int)targets.size()) return false;
+
+    // Edges must run straight out of their node, one per direction in the
+    // order WalkEdges finds them, to a node whose edge leads back the same way
+    long corridorCells = 0;
+    for (int i = 0; i < (int)savedNodes.size(); i++) {
+        const PathNode& node = savedNodes[i];
+        int lastDir = -1;
+        for (int e = node.firstEdge; e < node.firstEdge + node.edgeCount; e++) {
+            int target = targets[e];
+            if (target < 0 || target >= (int)savedNodes.size() || target == i) return false;
+            int dx = savedNodes[target].x - node.x;
+            int dy = savedNodes[target].y - node.y;
+            if ((dx != 0) == (dy != 0) || abs(dx) + abs(dy) != costs[e] - 1) return false;
+            int dir = dx > 0 ? 0 : dy > 0 ? 1 : dx < 0 ? 2 : 3;
+            if (dir <= lastDir || !IsPath(tiles, node.x + DX[dir], node.y + DY[dir])) return false;
+            lastDir = dir;
+
+            const PathNode& back = savedNodes[target];
+            bool returns = false;
+            for (int r = back.firstEdge; r < back.firstEdge + back.edgeCount; r++) {
+                if (targets[r] == i && costs[r] == costs[e]) returns = true;
             }
+            if (!returns) return false;
+            corridorCells += costs[e] - 2;
+        }
+    }
+
+    // Each corridor was counted from both ends; with the nodes they must
+    // cover every path cell exactly once
+    long pathCells = 0;
+    tiles.ForEachChunk([&](int, int, const TileGrid::Chunk& chunk) {
+        for (int i = 0; i < TileGrid::CHUNK_CELLS; i++) pathCells += chunk.cells[i].type == TileType::Path;
+    });
+    if ((long)savedNodes.size() + corridorCells / 2 != pathCells) return false;
+
+    nodes = std::move(savedNodes);
+    edgeTargets = std::move(targets);
+    edgeCosts = std::move(costs);
+    return true;
+}
+
+void PathGraph::ConnectNode(const TileGrid& tiles, int i) {
+    int targets[4], costs[4];
+    int count = WalkEdges(tiles, nodes[i].x, nodes[i].y, targets, costs);
+
+    // Edges are appended; any previous range becomes garbage until compaction
+    staleEdges += nodes[i].edgeCount;
+    nodes[i].firstEdge = (int)edgeTargets.size();
+    nodes[i].edgeCount = count;
+    edgeTargets.insert(edgeTargets.end(), targets, targets + count);
+    edgeCosts.insert(edgeCosts.end(), costs, costs + count);
+}
+
+int PathGraph::WalkEdges(const TileGrid& tiles, int nx, int ny, int targets[4], int costs[4]) const {
+    int count = 0;
+    for (int d = 0; d < 4; d++) {
+        int cx = nx + DX[d];
+        int cy = ny + DY[d];
+
+        if (!IsPath(tiles, cx, cy)) continue;
+
+        // Non-node path cells have exactly two opposite neighbours, so the
+        // corridor runs straight until it reaches another node
+        int cost = 2;
+        int target;
+        while ((target = nodeAt.At(cx, cy)) < 0) {
+            cx += DX[d];
+            cy += DY[d];
+            cost++;
+        }
+
+        targets[count] = target;
+        costs[count] = cost;
+        count++;
+    }
+    return count;
+}
+
+void PathGraph::CompactEdges() {
+    std::vector<int> targets;
+    std::vector<int> costs;
+    targets.reserve(edgeTargets.size() - staleEdges);
+    costs.reserve(edgeCosts.size() - staleEdges);
+    for (PathNode& node : nodes) {
+        int first = (int)targets.size();
+        for (int e = node.firstEdge; e < node.firstEdge + node.edgeCount; e++) {
+            targets.push_back(edgeTargets[e]);
+            costs.push_back(edgeCosts[e]);
         }
+        node.firstEdge = first;
     }
+    edgeTargets.swap(targets);
+    edgeCosts.swap(costs);
+    staleEdges = 0;
 }
 
-int PathGraph::FindNode(int x, int y) const {
-    auto it = posToNode.find(PosKey(x, y));
-    if (it != posToNode.end()) return it->second;
+// Follow a straight corridor from (x, y) in direction d; returns the node it ends at, or -1
+int PathGraph::WalkToNode(const TileGrid& tiles, int x, int y, int d) const {
+    while (IsPath(tiles, x, y)) {
+        int idx = FindNode(x, y);
+        if (idx >= 0) return idx;
+        // Non-node path cells are straight; stop if this one runs across the walk
+        if (!IsPath(tiles, x - DX[d], y - DY[d])) return -1;
+        x += DX[d];
+        y += DY[d];
+    }
     return -1;
 }
 
-void PathGraph::RenderDebug(GameCamera& camera) {
-    float halfTile = TILE_SIZE * camera.zoom * 0.5f;
+void PathGraph::RemoveNode(int idx) {
+    int last = (int)nodes.size() - 1;
+    nodeAt.Set(nodes[idx].x, nodes[idx].y, -1);
+    staleEdges += nodes[idx].edgeCount;
 
-    // Draw edges as yellow lines
-    for (int i = 0; i < (int)nodes.size(); i++) {
-        Vector2 from = WorldToScreen(nodes[i].x, nodes[i].y, camera.offset, camera.zoom);
-        from.x += halfTile;
-        from.y += halfTile;
+    if (idx != last) {
+        // Move the last node into the freed slot and retarget its neighbours' edges.
+        // Edges that still point at removed nodes belong to dirty nodes and get rebuilt.
+        nodes[idx] = nodes[last];
+        nodeAt.Set(nodes[idx].x, nodes[idx].y, idx);
+        const PathNode& moved = nodes[idx];
+        for (int e = moved.firstEdge; e < moved.firstEdge + moved.edgeCount; e++) {
+            int target = edgeTargets[e];
+            if (target >= last) continue;
+            const PathNode& neighbor = nodes[target];
+            for (int b = neighbor.firstEdge; b < neighbor.firstEdge + neighbor.edgeCount; b++) {
+                if (edgeTargets[b] == last) edgeTargets[b] = idx;
+            }
+        }
+    }
+    nodes.pop_back();
+}
 
-        for (auto& [target, cost] : nodes[i].edges) {
-            // Only draw each edge once (from lower index to higher)
-            if (target <= i) continue;
+void PathGraph::UpdateRegion(const TileGrid& tiles, int minX, int minY, int maxX, int maxY) {
+    if (maxX < minX || maxY < minY) return;
+    InvalidateCache();
 
-            Vector2 to = WorldToScreen(nodes[target].x, nodes[target].y, camera.offset, camera.zoom);
-            to.x += halfTile;
-            to.y += halfTile;
+    // Node status depends on a cell and its 4 neighbours, so it can only change
+    // within one cell of the edit
+    int x0 = std::max(minX - 1, 0);
+    int y0 = std::max(minY - 1, 0);
+    int x1 = std::min(maxX + 1, tiles.GetCols() - 1);
+    int y1 = std::min(maxY + 1, tiles.GetRows() - 1);
+    auto inside = [&](int x, int y) { return x >= x0 && x <= x1 && y >= y0 && y <= y1; };
 
-            DrawLineEx(from, to, 2.0f, YELLOW);
+    // Nodes outside the region whose corridors lead into it need new edges.
+    // Everything outside is unchanged, so the current index still finds them.
+    std::vector<GridPos> dirty;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            for (int d = 0; d < 4; d++) {
+                int ox = x + DX[d];
+                int oy = y + DY[d];
+                if (inside(ox, oy)) continue;
+                int idx = WalkToNode(tiles, ox, oy, d);
+                if (idx >= 0) dirty.push_back({nodes[idx].x, nodes[idx].y});
+            }
         }
     }
 
-    // Draw nodes as green circles on top
+    // Drop nodes that no longer qualify, add new ones
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int idx = FindNode(x, y);
+            bool isNode = IsNode(tiles, x, y);
+            if (idx >= 0 && !isNode) {
+                RemoveNode(idx);
+            } else if (idx < 0 && isNode) {
+                nodeAt.Set(x, y, (int)nodes.size());
+                nodes.push_back(PathNode{x, y, 0, 0});
+            }
+            if (isNode) dirty.push_back({x, y});
+        }
+    }
+
+    // Re-walk every corridor that touches the region
+    for (GridPos pos : dirty) {
+        int idx = nodeAt.At(pos.x, pos.y);
+        if (idx >= 0) ConnectNode(tiles, idx);
+    }
+
+    if (staleEdges > (int)edgeTargets.size() / 2) CompactEdges();
+}
+
+bool PathGraph::Matches(const PathGraph& other) const {
+    if (nodes.size() != other.nodes.size()) return false;
+
+    // Compare by position so node numbering does not matter
     for (const PathNode& node : nodes) {
-        Vector2 pos = WorldToScreen(node.x, node.y, camera.offset, camera.zoom);
-        float radius = 4.0f * camera.zoom;
-        DrawCircle((int)(pos.x + halfTile), (int)(pos.y + halfTile), radius, GREEN);
+        int j = other.FindNode(node.x, node.y);
+        if (j < 0) return false;
+        const PathNode& match = other.nodes[j];
+        if (node.edgeCount != match.edgeCount) return false;
+        for (int e = 0; e < node.edgeCount; e++) {
+            const PathNode& a = nodes[edgeTargets[node.firstEdge + e]];
+            const PathNode& b = other.nodes[other.edgeTargets[match.firstEdge + e]];
+            if (a.x != b.x || a.y != b.y) return false;
+            if (edgeCosts[node.firstEdge + e] != other.edgeCosts[match.firstEdge + e]) return false;
+        }
+    }
+    return true;
+}
+
+void PathGraph::InvalidateCache() {
+    cacheOrder.clear();
+    cacheIndex.clear();
+    componentsValid = false;
+}
+
+void PathGraph::LabelComponents() {
+    component.assign(nodes.size(), -1);
+    std::vector<int> stack;
+    int label = 0;
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        if (component[i] >= 0) continue;
+        component[i] = label;
+        stack.push_back(i);
+        while (!stack.empty()) {
+            int n = stack.back();
+            stack.pop_back();
+            for (int e = nodes[n].firstEdge; e < nodes[n].firstEdge + nodes[n].edgeCount; e++) {
+                int target = edgeTargets[e];
+                if (component[target] < 0) {
+                    component[target] = label;
+                    stack.push_back(target);
+                }
+            }
+        }
+        label++;
     }
+    componentsValid = true;
+}
+
+int PathGraph::CorridorEnds(const TileGrid& tiles, int x, int y, std::pair<int, int> ends[2]) const {
+    if (!IsPath(tiles, x, y)) return 0;
+
+    int idx = FindNode(x, y);
+    if (idx >= 0) {
+        ends[0] = {idx, 0};
+        return 1;
+    }
+
+    // Non-node path cells are straight: walk both ways along the axis
+    int d0 = IsPath(tiles, x + 1, y) ? 0 : 1;
+    int count = 0;
+    for (int d : { d0, d0 + 2 }) {
+        int node = WalkToNode(tiles, x + DX[d], y + DY[d], d);
+        if (node < 0) continue;
+        ends[count++] = {node, abs(nodes[node].x - x) + abs(nodes[node].y - y)};
+    }
+    return count;
+}
+
+// Append the straight run of tiles after 'from' up to and including 'to'
+static void AppendLine(std::vector<GridPos>& path, GridPos from, GridPos to) {
+    int sx = (to.x > from.x) - (to.x < from.x);
+    int sy = (to.y > from.y) - (to.y < from.y);
+    while (from.x != to.x || from.y != to.y) {
+        from.x += sx;
+        from.y += sy;
+        path.push_back(from);
+    }
+}
+
+bool PathGraph::FindPath(const TileGrid& tiles, GridPos from, GridPos to, std::vector<GridPos>& path) {
+    path.clear();
+    if (!IsPath(tiles, from.x, from.y) || !IsPath(tiles, to.x, to.y)) return false;
+
+    uint64_t key = ((uint64_t)(uint32_t)PosKey(from.x, from.y) << 32) | (uint32_t)PosKey(to.x, to.y);
+    auto hit = cacheIndex.find(key);
+    if (hit != cacheIndex.end()) {
+        cacheOrder.splice(cacheOrder.begin(), cacheOrder, hit->second);
+        path = hit->second->path;
+        return !path.empty();
+    }
+
+    Search(tiles, from, to, path);
+
+    // Failed lookups are cached too (as an empty path)
+    cacheOrder.push_front(CachedPath{key, path});
+    cacheIndex[key] = cacheOrder.begin();
+    if (cacheOrder.size() > PATH_CACHE_SIZE) {
+        cacheIndex.erase(cacheOrder.back().key);
+        cacheOrder.pop_back();
+    }
+    return !path.empty();
+}
+
+// A* over the node graph. Start and goal may sit mid-corridor, so the search is
+// seeded from both ends of the start corridor and finishes at either end of the
+// goal corridor. Edge costs count both end tiles, so steps are cost - 1.
+bool PathGraph::Search(const TileGrid& tiles, GridPos from, GridPos to, std::vector<GridPos>& path) {
+    std::pair<int, int> startEnds[2], goalEnds[2];
+    int startCount = CorridorEnds(tiles, from.x, from.y, startEnds);
+    int goalCount = CorridorEnds(tiles, to.x, to.y, goalEnds);
+    if (startCount == 0 || goalCount == 0) return false;
+
+    if (!componentsValid) LabelComponents();
+    if (component[startEnds[0].first] != component[goalEnds[0].first]) return false;
+
+    // Best complete route so far: via goal end 'bestEnd', or directly along a shared corridor
+    int best = INT32_MAX;
+    int bestEnd = -1;
+    bool sameCorridor = startCount == 2 && goalCount == 2 &&
+        ((startEnds[0].first == goalEnds[0].first && startEnds[1].first == goalEnds[1].first) ||
+         (startEnds[0].first == goalEnds[1].first && startEnds[1].first == goalEnds[0].first)) &&
+        (from.x == to.x || from.y == to.y);
+    if (sameCorridor || (from.x == to.x && from.y == to.y)) {
+        best = abs(from.x - to.x) + abs(from.y - to.y);
+    }
+
+    if (gScore.size() != nodes.size()) {
+        gScore.assign(nodes.size(), 0);
+        cameFrom.assign(nodes.size(), -1);
+        visited.assign(nodes.size(), 0);
+        searchStamp = 0;
+    }
+    if (++searchStamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        searchStamp = 1;
+    }
+
+    auto heuristic = [&](int n) { return abs(nodes[n].x - to.x) + abs(nodes[n].y - to.y); };
+    // Min-heap on f, preferring deeper entries on ties
+    auto worse = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); };
+    auto push = [&](int n, int g, int parent) {
+        if (visited[n] == searchStamp && gScore[n] <= g) return;
+        visited[n] = searchStamp;
+        gScore[n] = g;
+        cameFrom[n] = parent;
+        open.push_back({g + heuristic(n), g, n});
+        std::push_heap(open.begin(), open.end(), worse);
+    };
+
+    open.clear();
+    for (int i = 0; i < startCount; i++) push(startEnds[i].first, startEnds[i].second, -1);
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), worse);
+        OpenEntry cur = open.back();
+        open.pop_back();
+        if (cur.f >= best) break;
+        if (cur.g != gScore[cur.node]) continue;  // Stale entry
+
+        for (int i = 0; i < goalCount; i++) {
+            if (goalEnds[i].first == cur.node && cur.g + goalEnds[i].second < best) {
+                best = cur.g + goalEnds[i].second;
+                bestEnd = cur.node;
+            }
+        }
+
+        const PathNode& node = nodes[cur.node];
+        for (int e = node.firstEdge; e < node.firstEdge + node.edgeCount; e++) {
+            push(edgeTargets[e], cur.g + edgeCosts[e] - 1, cur.node);
+        }
+    }
+
+    if (best == INT32_MAX) return false;
+
+    path.push_back(from);
+    if (bestEnd < 0) {
+        AppendLine(path, from, to);
+        return true;
+    }
+
+    // Walk back from the goal end, then emit tiles front to back
+    std::vector<int> chain;
+    for (int n = bestEnd; n >= 0; n = cameFrom[n]) chain.push_back(n);
+
+    GridPos cur = from;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        GridPos next = { nodes[*it].x, nodes[*it].y };
+        AppendLine(path, cur, next);
+        cur = next;
+    }
+    AppendLine(path, cur, to);
+    return true;
 }
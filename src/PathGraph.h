@@ -1,30 +1,99 @@
 #pragma once
 
 #include "Tile.h"
-#include "Camera.h"
+#include "TileGrid.h"
+#include "WorkerPool.h"
 #include <vector>
+#include <list>
 #include <unordered_map>
+#include <cstdint>
+
+struct GridPos {
+    int x, y;
+};
 
 struct PathNode {
     int x, y;
-    // Each edge: {target node index, cost in tiles}
-    std::vector<std::pair<int, int>> edges;
+    // Edges live in the graph's CSR arrays at [firstEdge, firstEdge + edgeCount)
+    int firstEdge;
+    int edgeCount;
 };
 
 class PathGraph {
 private:
     std::vector<PathNode> nodes;
-    std::unordered_map<int, int> posToNode;
-    int maxCols = 0;
+    // Compressed sparse row adjacency: target node index and cost in tiles per edge
+    std::vector<int> edgeTargets;
+    std::vector<int> edgeCosts;
+    int staleEdges = 0;  // Slots orphaned by incremental updates, reclaimed by CompactEdges
+    // Sparse cell -> node index lookup, -1 where there is no node
+    ChunkedGrid<int32_t> nodeAt;
+
+    int PosKey(int x, int y) const { return y * nodeAt.GetCols() + x; }
+    void CompactEdges();
+    bool IsPath(const TileGrid& tiles, int x, int y) const;
+    int CountNeighbors(const TileGrid& tiles, int x, int y) const;
+    bool IsNode(const TileGrid& tiles, int x, int y) const;
+
+    // Recompute the edges of node i by walking its corridors
+    void ConnectNode(const TileGrid& tiles, int i);
+    // Edges out of the node at (x, y) into targets/costs; returns how many
+    int WalkEdges(const TileGrid& tiles, int x, int y, int targets[4], int costs[4]) const;
+    int WalkToNode(const TileGrid& tiles, int x, int y, int d) const;
+    void RemoveNode(int idx);
 
-    int PosKey(int x, int y) const { return y * maxCols + x; }
-    bool IsPath(const std::vector<std::vector<Tile>>& tiles, int x, int y, int rows, int cols) const;
-    int CountNeighbors(const std::vector<std::vector<Tile>>& tiles, int x, int y, int rows, int cols) const;
-    bool IsNode(const std::vector<std::vector<Tile>>& tiles, int x, int y, int rows, int cols) const;
+    // Nodes at either end of the corridor a path cell lies on: {node index, distance}
+    int CorridorEnds(const TileGrid& tiles, int x, int y, std::pair<int, int> ends[2]) const;
+    bool Search(const TileGrid& tiles, GridPos from, GridPos to, std::vector<GridPos>& path);
+
+    // A* scratch space, reused between queries (stamp marks entries valid for the current search)
+    struct OpenEntry {
+        int f, g, node;
+    };
+    std::vector<int> gScore;
+    std::vector<int> cameFrom;
+    std::vector<uint32_t> visited;
+    std::vector<OpenEntry> open;
+    uint32_t searchStamp = 0;
+
+    // Connected component per node, so unreachable queries fail without a search
+    std::vector<int> component;
+    bool componentsValid = false;
+    void LabelComponents();
+
+    // LRU cache of recent queries, cleared whenever the graph changes
+    static const size_t PATH_CACHE_SIZE = 256;
+    struct CachedPath {
+        uint64_t key;
+        std::vector<GridPos> path;
+    };
+    std::list<CachedPath> cacheOrder;
+    std::unordered_map<uint64_t, std::list<CachedPath>::iterator> cacheIndex;
+    void InvalidateCache();
+
+    // Nodes whose edges one Build task walks
+    static const int BUILD_NODES_PER_TASK = 4096;
 
 public:
-    void Build(const std::vector<std::vector<Tile>>& tiles, int rows, int cols);
-    void RenderDebug(GameCamera& camera);
+    // Splits both passes into tasks on the pool if one is given; the graph is
+    // identical to a serial build either way
+    void Build(const TileGrid& tiles, WorkerPool* pool = nullptr);
+    // Adopt a graph saved earlier instead of rebuilding it; nodes carry their own
+    // edge counts and edges are listed in node order. Returns false if it is
+    // inconsistent or does not fit the tiles.
+    bool Restore(const TileGrid& tiles, std::vector<PathNode> savedNodes,
+                 std::vector<int> targets, std::vector<int> costs);
+    // Patch the graph after the cells in [minX..maxX] x [minY..maxY] changed
+    void UpdateRegion(const TileGrid& tiles, int minX, int minY, int maxX, int maxY);
+    // True if both graphs have the same nodes and edges, regardless of node order
+    bool Matches(const PathGraph& other) const;
     const std::vector<PathNode>& GetNodes() const { return nodes; }
-    int FindNode(int x, int y) const;
+    const std::vector<int>& GetEdgeTargets() const { return edgeTargets; }
+    const std::vector<int>& GetEdgeCosts() const { return edgeCosts; }
+    int FindNode(int x, int y) const { return nodeAt.Get(x, y); }
+    size_t GetIndexMemoryBytes() const { return nodeAt.GetMemoryBytes(); }
+
+    // Shortest route between two path cells, one entry per tile including both ends.
+    // Returns false if either cell is not a path or they are not connected.
+    bool FindPath(const TileGrid& tiles, GridPos from, GridPos to, std::vector<GridPos>& path);
 };
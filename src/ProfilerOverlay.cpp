@@ -0,0 +1,66 @@
+#include "ProfilerOverlay.h"
+
+#if LOCO_PROFILE
+
+#include "raylib.h"
+#include <initializer_list>
+
+static const int OVERLAY_WIDTH = 360;
+static const int ROW_HEIGHT = 16;
+static const int GRAPH_HEIGHT = 64;
+// Top of the graph's scale; slower frames are clipped
+static const float GRAPH_MAX_MS = 50.0f;
+
+static void DrawStatsRow(const char* name, const FrameProfiler::Stats& stats, int x, int y, Color color) {
+    DrawText(name, x, y, 14, color);
+    if (stats.frames == 0) {
+        DrawText("-", x + 140, y, 14, GRAY);
+        return;
+    }
+    DrawText(TextFormat("%6.2f", stats.min / 1000.0), x + 140, y, 14, color);
+    DrawText(TextFormat("%6.2f", stats.avg / 1000.0), x + 205, y, 14, color);
+    DrawText(TextFormat("%6.2f", stats.p99 / 1000.0), x + 270, y, 14, color);
+}
+
+void DrawProfilerOverlay(const FrameProfiler& profiler, int x, int y) {
+    int frameCount = profiler.GetFrameCount();
+    int height = 10 + ROW_HEIGHT * (PROFILE_STAGE_COUNT + 2) + 10 + GRAPH_HEIGHT + 10;
+    DrawRectangle(x, y, OVERLAY_WIDTH, height, Color{0, 0, 0, 180});
+
+    int textX = x + 10;
+    int rowY = y + 10;
+    DrawText(TextFormat("ms over %d frames", frameCount), textX, rowY, 14, LIGHTGRAY);
+    DrawText("min", textX + 150, rowY, 14, LIGHTGRAY);
+    DrawText("avg", textX + 215, rowY, 14, LIGHTGRAY);
+    DrawText("p99", textX + 280, rowY, 14, LIGHTGRAY);
+    rowY += ROW_HEIGHT;
+
+    DrawStatsRow("Frame", profiler.GetFrameStats(), textX, rowY, YELLOW);
+    rowY += ROW_HEIGHT;
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        ProfileStage stage = static_cast<ProfileStage>(i);
+        DrawStatsRow(GetProfileStageName(stage), profiler.GetStageStats(stage), textX + 10, rowY, WHITE);
+        rowY += ROW_HEIGHT;
+    }
+
+    // One bar per frame, newest on the right, with 60 and 30 fps marks
+    int graphX = textX;
+    int graphY = rowY + 10;
+    int graphWidth = OVERLAY_WIDTH - 20;
+    float scale = GRAPH_HEIGHT / GRAPH_MAX_MS;
+    DrawRectangle(graphX, graphY, graphWidth, GRAPH_HEIGHT, Color{40, 40, 40, 200});
+    float barWidth = (float)graphWidth / FrameProfiler::FRAME_COUNT;
+    for (int age = 0; age < frameCount; age++) {
+        float ms = (float)(profiler.GetFrame(age).duration / 1000.0);
+        float barHeight = ms < GRAPH_MAX_MS ? ms * scale : (float)GRAPH_HEIGHT;
+        Color color = ms > 33.4f ? RED : ms > 16.7f ? ORANGE : GREEN;
+        float barX = graphX + graphWidth - (age + 1) * barWidth;
+        DrawRectangleRec({ barX, graphY + GRAPH_HEIGHT - barHeight, barWidth, barHeight }, color);
+    }
+    for (float mark : { 1000.0f / 60.0f, 1000.0f / 30.0f }) {
+        int markY = graphY + GRAPH_HEIGHT - (int)(mark * scale);
+        DrawLine(graphX, markY, graphX + graphWidth, markY, Color{255, 255, 255, 120});
+    }
+}
+
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "FrameProfiler.h"
+
+#if LOCO_PROFILE
+
+// Per-stage min/avg/p99 over the profiler's frames and a graph of frame times,
+// drawn with its top-left corner at (x, y)
+void DrawProfilerOverlay(const FrameProfiler& profiler, int x, int y);
+
+#endif
@@ -1,51 +1,538 @@
 #include "SaveFileHandler.h"
 #include "World.h"
-#include <fstream>
+#include "MappedFile.h"
 #include <sstream>
 #include <filesystem>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+#include <vector>
+#include <chrono>
 
-bool SaveFileHandler::Save(const World& world, const std::string& filepath) const {
+// Binary save layout (little-endian, native struct layout):
+//   FileHeader, chunkCount ChunkEntry records, then the chunk payloads (8-byte aligned)
+//   TCHK  tiles in square chunks, only those with something built in them:
+//         uint32 chunkSize, uint32 count, count x {int32 cx, cy} chunk coordinates,
+//         then count x chunkSize * chunkSize packed Tile structs (row-major, connections included)
+//   TILE  version 1 only, read for old saves: rows * cols packed Tile structs, row-major
+//   BLDG  uint32 count, then count BuildingRecord
+//   PGRF  optional cached path graph: uint32 nodeCount, uint32 edgeCount,
+//         nodeCount x {int32 x, y, edgeCount}, edgeCount int32 targets, edgeCount int32 costs
+//   JRNL  uint64 journal lineage, uint64 first journal sequence number not in this snapshot
+// Readers skip chunks they don't know, so new chunks don't need a version bump.
+// Saves are written and read in place as host structs, so hosts must be little-endian
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "binary saves assume a little-endian host"
+#endif
+static const char SAVE_MAGIC[4] = { 'L', 'O', 'C', 'O' };
+static const uint32_t SAVE_VERSION = 2;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t chunkCount;
+    uint32_t reserved;
+};
+
+struct ChunkEntry {
+    char id[4];
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+static_assert(sizeof(ChunkEntry) == 24, "ChunkEntry layout");
+
+struct TileChunkHeader {
+    uint32_t chunkSize;
+    uint32_t count;
+};
+
+struct BuildingRecord {
+    int32_t x;
+    int32_t y;
+    int32_t type;
+};
+
+static_assert(sizeof(FileHeader) == 24, "FileHeader layout");
+
+// Journal flush-to-disk cadence and the size at which it is folded into a new snapshot
+static const float JOURNAL_SYNC_INTERVAL = 2.0f;
+static const size_t JOURNAL_COMPACT_RECORDS = 65536;
+
+static bool EndsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+WorldSnapshot SaveFileHandler::TakeSnapshot(const World& world) {
+    const PathGraph& graph = world.GetPathGraph();
+    WorldSnapshot snapshot;
+    snapshot.tiles = world.GetTiles();
+    snapshot.buildings = world.GetBuildings();
+    snapshot.nodes = graph.GetNodes();
+    snapshot.edgeTargets = graph.GetEdgeTargets();
+    snapshot.edgeCosts = graph.GetEdgeCosts();
+    return snapshot;
+}
+
+bool SaveFileHandler::Save(const WorldSnapshot& snapshot, const std::string& filepath) {
     // Ensure directory exists
     std::filesystem::path path(filepath);
-    std::filesystem::create_directories(path.parent_path());
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::ostringstream out(std::ios::binary);
+    if (EndsWith(filepath, ".json")) SaveJson(snapshot, out);
+    else SaveBinary(snapshot, out);
+    if (!out.good()) return false;
+    std::string contents = out.str();
+    return WriteFileAtomic(filepath, contents.data(), contents.size());
+}
+
+bool SaveFileHandler::Save(const World& world, const std::string& filepath) const {
+    return Save(TakeSnapshot(world), filepath);
+}
+
+WorldSnapshot SaveFileHandler::TakeSnapshotFor(const World& world, const std::string& filepath) const {
+    WorldSnapshot snapshot = TakeSnapshot(world);
+    // A snapshot of the journaled save folds in every edit recorded so far
+    if (journal.IsOpen() && filepath == journalSavePath) {
+        snapshot.journalLineage = journal.GetLineage();
+        snapshot.journalSeq = journal.GetNextSeq();
+    }
+    return snapshot;
+}
+
+void SaveFileHandler::StartSave(WorldSnapshot snapshot, const std::string& filepath, bool requested) {
+    pendingCheckpoint = snapshot.journalLineage != 0;
+    if (pendingCheckpoint) {
+        pendingLineage = snapshot.journalLineage;
+        pendingSeq = snapshot.journalSeq;
+        checkpointRequested = false;
+    }
+    pendingRequested = requested;
+    pendingSave = std::async(std::launch::async,
+        [snapshot = std::move(snapshot), filepath]() { return Save(snapshot, filepath); });
+}
+
+void SaveFileHandler::SaveAsync(const World& world, const std::string& filepath) {
+    WorldSnapshot snapshot = TakeSnapshotFor(world, filepath);
+    if (IsSaving()) {
+        queuedSnapshot = std::move(snapshot);
+        queuedPath = filepath;
+        saveQueued = true;
+        return;
+    }
+    StartSave(std::move(snapshot), filepath, true);
+}
+
+bool SaveFileHandler::IsSaving() const {
+    return pendingSave.valid();
+}
+
+bool SaveFileHandler::PollSave(bool& succeeded) {
+    if (requestedFinished) {
+        requestedFinished = false;
+        succeeded = requestedResult;
+        return true;
+    }
+    if (!pendingSave.valid() ||
+        pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    bool requested = pendingRequested;
+    FinishSave(succeeded);
+    if (saveQueued) {
+        saveQueued = false;
+        StartSave(std::move(queuedSnapshot), queuedPath, true);
+    }
+    return requested;
+}
+
+void SaveFileHandler::FinishSave(bool& succeeded) {
+    succeeded = pendingSave.get();
+    // The snapshot is on disk, so the journal only needs the edits made since
+    if (succeeded && pendingCheckpoint && journal.GetLineage() == pendingLineage) {
+        journal.Rebase(pendingSeq);
+    }
+    pendingCheckpoint = false;
+}
+
+void SaveFileHandler::WaitForSave() {
+    while (pendingSave.valid()) {
+        bool requested = pendingRequested;
+        bool succeeded;
+        FinishSave(succeeded);
+        if (requested) {
+            // Reported by the next PollSave; a later requested save overrides a success
+            requestedResult = requestedFinished ? requestedResult && succeeded : succeeded;
+            requestedFinished = true;
+        }
+        if (saveQueued) {
+            saveQueued = false;
+            StartSave(std::move(queuedSnapshot), queuedPath, true);
+        }
+    }
+}
+
+bool SaveFileHandler::StartJournal(const World& world, const std::string& journalPath) {
+    // The snapshot must name the new lineage before the journal does, so a crash
+    // in between leaves a mismatch (journal ignored) rather than misapplied edits
+    uint64_t lineage = EditJournal::NewLineage();
+    WorldSnapshot snapshot = TakeSnapshot(world);
+    snapshot.journalLineage = lineage;
+    if (!Save(snapshot, journalSavePath)) {
+        lastError = "cannot write " + journalSavePath;
+        return false;
+    }
+    if (!journal.Create(journalPath, lineage, 0)) {
+        lastError = "cannot create " + journalPath;
+        return false;
+    }
+    checkpointRequested = false;
+    return true;
+}
+
+bool SaveFileHandler::OpenWorld(World& world, const std::string& savePath) {
+    WaitForSave();
+    world.SetJournal(nullptr);
+    journal.Close();
+    journalSavePath = savePath;
+    lastReplayed = 0;
+    std::string journalPath = savePath + ".journal";
+
+    // Without a snapshot the current world starts a new history
+    if (!std::filesystem::exists(savePath)) {
+        if (!StartJournal(world, journalPath)) return false;
+        world.SetJournal(&journal);
+        return true;
+    }
+
+    if (!Load(world, savePath)) return false;
+
+    std::vector<JournalRecord> applied;
+    int replayed = loadedLineage != 0
+        ? EditJournal::Replay(journalPath, loadedLineage, loadedSeq, world, applied)
+        : -1;
+    if (replayed >= 0) {
+        if (!journal.Create(journalPath, loadedLineage, loadedSeq, std::move(applied))) {
+            lastError = "cannot create " + journalPath;
+            return false;
+        }
+        lastReplayed = replayed;
+    } else if (!StartJournal(world, journalPath)) {
+        return false;
+    }
+
+    world.SetJournal(&journal);
+    return true;
+}
 
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
+void SaveFileHandler::StartNewLineage(const World& world) {
+    if (!journal.IsOpen()) return;
+    WaitForSave();
+    StartJournal(world, journalSavePath + ".journal");
+}
+
+void SaveFileHandler::Autosave(const World& world, float dt) {
+    if (!journal.IsOpen()) return;
+
+    // Handing records to the OS each frame survives a process crash; the
+    // periodic sync covers power loss
+    journal.Flush();
+    syncTimer += dt;
+    if (syncTimer >= JOURNAL_SYNC_INTERVAL) {
+        syncTimer = 0.0f;
+        journal.Sync();
+    }
+
+    if (journal.GetRecordCount() >= JOURNAL_COMPACT_RECORDS) checkpointRequested = true;
+    if (checkpointRequested && !IsSaving()) StartSave(TakeSnapshotFor(world, journalSavePath), journalSavePath, false);
+}
+
+bool SaveFileHandler::Load(World& world, const std::string& filepath) {
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        lastError = "cannot open " + filepath;
         return false;
     }
 
-    int rows = world.GetRows();
-    int cols = world.GetCols();
+    // The buildings placed while loading are not edits: keep them out of the
+    // journal and the undo history
+    EditJournal* worldJournal = world.GetJournal();
+    EditHistory* worldHistory = world.GetHistory();
+    world.SetJournal(nullptr);
+    world.SetHistory(nullptr);
+
+    bool loaded;
+    if (file.Size() >= sizeof(SAVE_MAGIC) && memcmp(file.Data(), SAVE_MAGIC, sizeof(SAVE_MAGIC)) == 0) {
+        loaded = LoadBinary(world, file.Data(), file.Size());
+        if (!loaded) lastError = "corrupt or unsupported save file";
+    } else {
+        loaded = LoadJson(world, reinterpret_cast<const char*>(file.Data()), file.Size());
+    }
+
+    world.SetJournal(worldJournal);
+    world.SetHistory(worldHistory);
+    // The old journal no longer applies to the loaded world
+    if (loaded && worldJournal == &journal) StartNewLineage(world);
+    return loaded;
+}
+
+void SaveFileHandler::SaveBinary(const WorldSnapshot& snapshot, std::ostream& file) {
+    const TileGrid& tiles = snapshot.tiles;
+    const std::vector<PathNode>& nodes = snapshot.nodes;
+
+    // Live buildings and graph edges (the CSR arrays may hold stale slots)
+    std::vector<BuildingRecord> buildingRecords;
+    for (const Building& b : snapshot.buildings) {
+        if (b.type == BuildingType::None) continue;
+        buildingRecords.push_back({b.gridX, b.gridY, static_cast<int32_t>(b.type)});
+    }
+    std::vector<int32_t> nodeRecords;
+    std::vector<int32_t> edgeTargets;
+    std::vector<int32_t> edgeCosts;
+    nodeRecords.reserve(nodes.size() * 3);
+    for (const PathNode& node : nodes) {
+        nodeRecords.insert(nodeRecords.end(), {node.x, node.y, node.edgeCount});
+        for (int e = node.firstEdge; e < node.firstEdge + node.edgeCount; e++) {
+            edgeTargets.push_back(snapshot.edgeTargets[e]);
+            edgeCosts.push_back(snapshot.edgeCosts[e]);
+        }
+    }
+
+    uint32_t buildingCount = (uint32_t)buildingRecords.size();
+    uint32_t graphCounts[2] = { (uint32_t)nodes.size(), (uint32_t)edgeTargets.size() };
+    uint64_t journalPosition[2] = { snapshot.journalLineage, snapshot.journalSeq };
+
+    // Allocated tile chunks are exactly the ones with a non-empty cell
+    std::vector<const TileGrid::Chunk*> tileChunks;
+    std::vector<int32_t> tileChunkCoords;
+    tiles.ForEachChunk([&](int cx, int cy, const TileGrid::Chunk& chunk) {
+        tileChunks.push_back(&chunk);
+        tileChunkCoords.insert(tileChunkCoords.end(), {cx, cy});
+    });
+    TileChunkHeader tileHeader = { (uint32_t)TileGrid::CHUNK_SIZE, (uint32_t)tileChunks.size() };
+    size_t chunkBytes = TileGrid::CHUNK_CELLS * sizeof(Tile);
+
+    ChunkEntry chunks[4] = {
+        { {'T', 'C', 'H', 'K'}, 0, 0, sizeof(tileHeader) + tileChunkCoords.size() * sizeof(int32_t) + tileChunks.size() * chunkBytes },
+        { {'B', 'L', 'D', 'G'}, 0, 0, sizeof(buildingCount) + buildingRecords.size() * sizeof(BuildingRecord) },
+        { {'P', 'G', 'R', 'F'}, 0, 0, sizeof(graphCounts) + (nodeRecords.size() + edgeTargets.size() * 2) * sizeof(int32_t) },
+        { {'J', 'R', 'N', 'L'}, 0, 0, sizeof(journalPosition) },
+    };
+    uint64_t offset = sizeof(FileHeader) + sizeof(chunks);
+    for (ChunkEntry& chunk : chunks) {
+        chunk.offset = offset;
+        offset = (offset + chunk.size + 7) & ~(uint64_t)7;
+    }
+
+    FileHeader header = {
+        {SAVE_MAGIC[0], SAVE_MAGIC[1], SAVE_MAGIC[2], SAVE_MAGIC[3]},
+        SAVE_VERSION, (uint32_t)tiles.GetRows(), (uint32_t)tiles.GetCols(), 4, 0
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(chunks), sizeof(chunks));
+
+    auto pad = [&](const ChunkEntry& chunk) {
+        static const char zeros[8] = {};
+        uint64_t end = chunk.offset + chunk.size;
+        file.write(zeros, (std::streamsize)(((end + 7) & ~(uint64_t)7) - end));
+    };
+
+    // Tile chunks straight from the grid's storage
+    file.write(reinterpret_cast<const char*>(&tileHeader), sizeof(tileHeader));
+    file.write(reinterpret_cast<const char*>(tileChunkCoords.data()), (std::streamsize)(tileChunkCoords.size() * sizeof(int32_t)));
+    for (const TileGrid::Chunk* chunk : tileChunks) {
+        file.write(reinterpret_cast<const char*>(chunk->cells), (std::streamsize)chunkBytes);
+    }
+    pad(chunks[0]);
+
+    file.write(reinterpret_cast<const char*>(&buildingCount), sizeof(buildingCount));
+    file.write(reinterpret_cast<const char*>(buildingRecords.data()), (std::streamsize)(buildingRecords.size() * sizeof(BuildingRecord)));
+    pad(chunks[1]);
+
+    file.write(reinterpret_cast<const char*>(graphCounts), sizeof(graphCounts));
+    file.write(reinterpret_cast<const char*>(nodeRecords.data()), (std::streamsize)(nodeRecords.size() * sizeof(int32_t)));
+    file.write(reinterpret_cast<const char*>(edgeTargets.data()), (std::streamsize)(edgeTargets.size() * sizeof(int32_t)));
+    file.write(reinterpret_cast<const char*>(edgeCosts.data()), (std::streamsize)(edgeCosts.size() * sizeof(int32_t)));
+    pad(chunks[2]);
+
+    file.write(reinterpret_cast<const char*>(journalPosition), sizeof(journalPosition));
+}
+
+bool SaveFileHandler::LoadBinary(World& world, const unsigned char* data, size_t size) {
+    FileHeader header;
+    if (size < sizeof(header)) return false;
+    memcpy(&header, data, sizeof(header));
+    if (header.version == 0 || header.version > SAVE_VERSION) return false;
+    if ((uint64_t)header.chunkCount * sizeof(ChunkEntry) > size - sizeof(header)) return false;
+
+    // Locate known chunks, rejecting any that run past the end of the file
+    const unsigned char* tileChunk = nullptr;
+    const unsigned char* tileChunksChunk = nullptr;
+    const unsigned char* buildingChunk = nullptr;
+    const unsigned char* graphChunk = nullptr;
+    const unsigned char* journalChunk = nullptr;
+    uint64_t tileSize = 0, tileChunksSize = 0, buildingSize = 0, graphSize = 0, journalSize = 0;
+    for (uint32_t i = 0; i < header.chunkCount; i++) {
+        ChunkEntry chunk;
+        memcpy(&chunk, data + sizeof(header) + i * sizeof(ChunkEntry), sizeof(chunk));
+        if (chunk.offset > size || chunk.size > size - chunk.offset) return false;
+
+        const unsigned char* payload = data + chunk.offset;
+        if (memcmp(chunk.id, "TILE", 4) == 0) { tileChunk = payload; tileSize = chunk.size; }
+        else if (memcmp(chunk.id, "TCHK", 4) == 0) { tileChunksChunk = payload; tileChunksSize = chunk.size; }
+        else if (memcmp(chunk.id, "BLDG", 4) == 0) { buildingChunk = payload; buildingSize = chunk.size; }
+        else if (memcmp(chunk.id, "PGRF", 4) == 0) { graphChunk = payload; graphSize = chunk.size; }
+        else if (memcmp(chunk.id, "JRNL", 4) == 0) { journalChunk = payload; journalSize = chunk.size; }
+    }
+
+    // Reject tile data that would send anchor lookups out of range
+    auto validPlane = [](const Tile* plane, int planeRows, int planeCols, int originX, int originY) {
+        for (int y = 0; y < planeRows; y++) {
+            for (int x = 0; x < planeCols; x++) {
+                const Tile& t = plane[(size_t)y * planeCols + x];
+                if (t.type > TileType::TrackCorner) return false;
+                if (originX + x + t.AnchorOffsetX() < 0 || originY + y + t.AnchorOffsetY() < 0) return false;
+            }
+        }
+        return true;
+    };
+
+    // Version 2 stores square chunks of tiles, version 1 one plane for the whole map
+    struct TilePlane {
+        const Tile* tiles;
+        int size;
+        int originX, originY;
+    };
+    std::vector<TilePlane> planes;
+    if (header.version >= 2) {
+        TileChunkHeader tileHeader;
+        if (!tileChunksChunk || tileChunksSize < sizeof(tileHeader)) return false;
+        memcpy(&tileHeader, tileChunksChunk, sizeof(tileHeader));
+        if (tileHeader.chunkSize == 0 || tileHeader.chunkSize > 1024) return false;
+        uint64_t chunkBytes = (uint64_t)tileHeader.chunkSize * tileHeader.chunkSize * sizeof(Tile);
+        if (tileChunksSize != sizeof(tileHeader) + tileHeader.count * (2 * sizeof(int32_t) + chunkBytes)) return false;
+
+        uint64_t chunkCols = (header.cols + tileHeader.chunkSize - 1) / tileHeader.chunkSize;
+        uint64_t chunkRows = (header.rows + tileHeader.chunkSize - 1) / tileHeader.chunkSize;
+        const unsigned char* coords = tileChunksChunk + sizeof(tileHeader);
+        const unsigned char* cells = coords + tileHeader.count * 2 * sizeof(int32_t);
+        for (uint32_t i = 0; i < tileHeader.count; i++) {
+            int32_t coord[2];
+            memcpy(coord, coords + i * sizeof(coord), sizeof(coord));
+            if (coord[0] < 0 || coord[1] < 0 || (uint64_t)coord[0] >= chunkCols || (uint64_t)coord[1] >= chunkRows) return false;
+            int size = (int)tileHeader.chunkSize;
+            const Tile* plane = reinterpret_cast<const Tile*>(cells + i * chunkBytes);
+            if (!validPlane(plane, size, size, coord[0] * size, coord[1] * size)) return false;
+            planes.push_back({plane, size, coord[0] * size, coord[1] * size});
+        }
+    } else {
+        uint64_t tileCount = (uint64_t)header.rows * header.cols;
+        if (!tileChunk || tileSize != tileCount * sizeof(Tile)) return false;
+        const Tile* plane = reinterpret_cast<const Tile*>(tileChunk);
+        if (!validPlane(plane, (int)header.rows, (int)header.cols, 0, 0)) return false;
+    }
+
+    // Buildings are placed after the world is cleared, so check them first
+    uint32_t buildingCount = 0;
+    if (buildingChunk && buildingSize >= sizeof(uint32_t)) {
+        memcpy(&buildingCount, buildingChunk, sizeof(buildingCount));
+        if (buildingCount > (buildingSize - sizeof(buildingCount)) / sizeof(BuildingRecord)) return false;
+        for (uint32_t i = 0; i < buildingCount; i++) {
+            BuildingRecord record;
+            memcpy(&record, buildingChunk + sizeof(buildingCount) + i * sizeof(record), sizeof(record));
+            if (record.type <= (int32_t)BuildingType::None || record.type >= BUILDING_TYPE_COUNT) return false;
+        }
+    }
+
+    loadedLineage = 0;
+    loadedSeq = 0;
+    if (journalChunk && journalSize == 2 * sizeof(uint64_t)) {
+        memcpy(&loadedLineage, journalChunk, sizeof(uint64_t));
+        memcpy(&loadedSeq, journalChunk + sizeof(uint64_t), sizeof(uint64_t));
+    }
+
+    world.Clear();
+    if (header.version >= 2) {
+        for (const TilePlane& plane : planes) {
+            world.SetTilePlane(plane.tiles, plane.size, plane.size, plane.originX, plane.originY);
+        }
+    } else {
+        world.SetTilePlane(reinterpret_cast<const Tile*>(tileChunk), (int)header.rows, (int)header.cols);
+    }
+
+    for (uint32_t i = 0; i < buildingCount; i++) {
+        BuildingRecord record;
+        memcpy(&record, buildingChunk + sizeof(buildingCount) + i * sizeof(record), sizeof(record));
+        world.PlaceBuilding(static_cast<BuildingType>(record.type), record.x, record.y);
+    }
+
+    // Stored connections are only valid if the whole plane fit
+    bool sameSize = (int)header.rows == world.GetRows() && (int)header.cols == world.GetCols();
+    if (!sameSize) world.UpdateAllConnections();
+
+    bool graphRestored = false;
+    if (graphChunk && sameSize && graphSize >= 2 * sizeof(uint32_t)) {
+        uint32_t counts[2];
+        memcpy(counts, graphChunk, sizeof(counts));
+        uint64_t expected = sizeof(counts) + ((uint64_t)counts[0] * 3 + (uint64_t)counts[1] * 2) * sizeof(int32_t);
+        if (expected == graphSize) {
+            const unsigned char* cursor = graphChunk + sizeof(counts);
+            std::vector<PathNode> nodes(counts[0]);
+            for (PathNode& node : nodes) {
+                int32_t record[3];
+                memcpy(record, cursor, sizeof(record));
+                cursor += sizeof(record);
+                node = PathNode{record[0], record[1], 0, record[2]};
+            }
+            std::vector<int> targets(counts[1]);
+            std::vector<int> costs(counts[1]);
+            memcpy(targets.data(), cursor, counts[1] * sizeof(int32_t));
+            memcpy(costs.data(), cursor + counts[1] * sizeof(int32_t), counts[1] * sizeof(int32_t));
+            graphRestored = world.RestorePathGraph(std::move(nodes), std::move(targets), std::move(costs));
+        }
+    }
+    // A graph that doesn't match the tiles is rebuilt from them
+    if (!graphRestored) world.RebuildPathGraph();
+    world.RebuildTrackGraph();
+
+    return true;
+}
+
+void SaveFileHandler::SaveJson(const WorldSnapshot& snapshot, std::ostream& file) {
+    const TileGrid& tiles = snapshot.tiles;
+    int rows = tiles.GetRows();
+    int cols = tiles.GetCols();
 
     file << "{\n";
     file << "  \"rows\": " << rows << ",\n";
     file << "  \"cols\": " << cols << ",\n";
 
-    // Save tiles
+    // Save tiles, chunk by chunk
     file << "  \"tiles\": [\n";
     bool first = true;
-    for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            Tile tile = world.GetTile(x, y);
-            if (tile.type != TileType::Empty) {
-                if (!first) file << ",\n";
-                first = false;
-                file << "    {\"x\": " << x
-                     << ", \"y\": " << y
-                     << ", \"type\": " << static_cast<int>(tile.type)
-                     << ", \"rotation\": " << tile.rotation << "}";
-            }
-        }
-    }
+    tiles.ForEachSet([&](int x, int y, const Tile& tile) {
+        if (!first) file << ",\n";
+        first = false;
+        file << "    {\"x\": " << x
+             << ", \"y\": " << y
+             << ", \"type\": " << static_cast<int>(tile.type)
+             << ", \"rotation\": " << QuarterTurnsToDegrees(tile.rotation) << "}";
+    });
     file << "\n  ],\n";
 
     // Save buildings
     file << "  \"buildings\": [\n";
-    const auto& buildings = world.GetBuildings();
-    for (size_t i = 0; i < buildings.size(); i++) {
-        const Building& b = buildings[i];
+    first = true;
+    for (const Building& b : snapshot.buildings) {
         if (b.type == BuildingType::None) continue;
-        if (i > 0) file << ",\n";
+        if (!first) file << ",\n";
+        first = false;
         file << "    {\"x\": " << b.gridX
              << ", \"y\": " << b.gridY
              << ", \"type\": " << static_cast<int>(b.type) << "}";
@@ -53,76 +540,237 @@ bool SaveFileHandler::Save(const World& world, const std::string& filepath) cons
     file << "\n  ]\n";
 
     file << "}\n";
-
-    return true;
 }
 
-bool SaveFileHandler::Load(World& world, const std::string& filepath) const {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+
+// Single-pass reader over the mapped JSON text. Only the subset written by
+// SaveJson is understood as data; other values are skipped. Errors record
+// the byte offset they were found at.
+class JsonReader {
+private:
+    std::string_view text;
+    size_t pos = 0;
+    size_t errorPos = 0;
+    const char* error = nullptr;
+
+public:
+    explicit JsonReader(std::string_view text) : text(text) {}
+
+    bool Fail(const char* message) {
+        if (!error) {
+            error = message;
+            errorPos = pos;
+        }
         return false;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string content = buffer.str();
+    void SkipWhitespace() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t')) pos++;
+    }
+
+    bool Peek(char c) {
+        SkipWhitespace();
+        return pos < text.size() && text[pos] == c;
+    }
 
-    world.Clear();
+    bool Consume(char c) {
+        if (!Peek(c)) return false;
+        pos++;
+        return true;
+    }
+
+    bool Expect(char c, const char* message) {
+        return Consume(c) || Fail(message);
+    }
 
-    // Parse tiles
-    size_t tilesStart = content.find("\"tiles\":");
-    size_t buildingsStart = content.find("\"buildings\":");
+    bool AtEnd() {
+        SkipWhitespace();
+        return pos == text.size();
+    }
 
-    // Determine where the tiles array ends
-    size_t tilesEnd = (buildingsStart != std::string::npos) ? buildingsStart : content.size();
+    // Keys are plain ASCII in our files, so escapes are only skipped over
+    bool ReadString(std::string_view& out) {
+        if (!Expect('"', "expected string")) return false;
+        size_t start = pos;
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\') pos++;
+            pos++;
+        }
+        if (pos >= text.size()) return Fail("unterminated string");
+        out = text.substr(start, pos - start);
+        pos++;
+        return true;
+    }
 
-    if (tilesStart != std::string::npos) {
-        size_t pos = tilesStart;
-        while ((pos = content.find("{\"x\":", pos)) != std::string::npos && pos < tilesEnd) {
-            size_t xStart = pos + 5;
-            int x = std::stoi(content.substr(xStart));
+    bool ReadKey(std::string_view& key) {
+        return ReadString(key) && Expect(':', "expected ':' after key");
+    }
 
-            size_t yPos = content.find("\"y\":", pos);
-            int y = std::stoi(content.substr(yPos + 4));
+    template <typename T>
+    bool ReadNumber(T& value) {
+        SkipWhitespace();
+        const char* first = text.data() + pos;
+        const char* last = text.data() + text.size();
+        if (first < last && *first == '+') return Fail("expected number");
+        auto result = std::from_chars(first, last, value);
+        if (result.ec != std::errc()) return Fail("expected number");
+        pos += (size_t)(result.ptr - first);
+        return true;
+    }
 
-            size_t typePos = content.find("\"type\":", pos);
-            int type = std::stoi(content.substr(typePos + 7));
+    bool ReadInt(int& value) {
+        if (!ReadNumber(value)) return false;
+        // Reject fractions and exponents rather than silently truncating
+        if (pos < text.size() && (text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E')) return Fail("expected integer");
+        return true;
+    }
 
-            float rotation = 0.0f;
-            size_t nextBrace = content.find("}", pos);
-            size_t rotPos = content.find("\"rotation\":", pos);
-            if (rotPos != std::string::npos && rotPos < nextBrace) {
-                rotation = std::stof(content.substr(rotPos + 11));
+    bool SkipValue(int depth = 0) {
+        if (depth > 64) return Fail("nesting too deep");
+        SkipWhitespace();
+        if (pos >= text.size()) return Fail("unexpected end of file");
+        char c = text[pos];
+        if (c == '"') {
+            std::string_view ignored;
+            return ReadString(ignored);
+        }
+        if (c == '{' || c == '[') {
+            char close = (c == '{') ? '}' : ']';
+            pos++;
+            if (Consume(close)) return true;
+            do {
+                if (c == '{') {
+                    std::string_view ignored;
+                    if (!ReadKey(ignored)) return false;
+                }
+                if (!SkipValue(depth + 1)) return false;
+            } while (Consume(','));
+            return Expect(close, c == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+        }
+        for (std::string_view literal : {"true", "false", "null"}) {
+            if (text.compare(pos, literal.size(), literal) == 0) {
+                pos += literal.size();
+                return true;
             }
+        }
+        double ignored;
+        return ReadNumber(ignored);
+    }
 
-            if (x >= 0 && x < world.GetCols() && y >= 0 && y < world.GetRows()) {
-                world.SetTileRaw(x, y, static_cast<TileType>(type), rotation);
+    // Iterates "{...}" records of an array, calling field(key) for each member
+    template <typename FieldFn, typename EndFn>
+    bool ReadObjectArray(FieldFn field, EndFn endRecord) {
+        if (!Expect('[', "expected '['")) return false;
+        if (Consume(']')) return true;
+        do {
+            if (!Expect('{', "expected '{'")) return false;
+            if (!Consume('}')) {
+                do {
+                    std::string_view key;
+                    if (!ReadKey(key) || !field(key)) return false;
+                } while (Consume(','));
+                if (!Expect('}', "expected ',' or '}'")) return false;
             }
+            if (!endRecord()) return false;
+        } while (Consume(','));
+        return Expect(']', "expected ',' or ']'");
+    }
 
-            pos++;
+    // "line L, column C: message" for the first recorded error
+    std::string ErrorString() const {
+        int line = 1;
+        size_t lineStart = 0;
+        for (size_t i = 0; i < errorPos && i < text.size(); i++) {
+            if (text[i] == '\n') {
+                line++;
+                lineStart = i + 1;
+            }
         }
+        return "line " + std::to_string(line) + ", column " + std::to_string(errorPos - lineStart + 1) +
+               " (offset " + std::to_string(errorPos) + "): " + (error ? error : "parse error");
     }
+};
 
-    // Parse buildings
-    if (buildingsStart != std::string::npos) {
-        size_t pos = buildingsStart;
-        while ((pos = content.find("{\"x\":", pos)) != std::string::npos) {
-            size_t xStart = pos + 5;
-            int x = std::stoi(content.substr(xStart));
+struct JsonTileRecord {
+    int x;
+    int y;
+    TileType type;
+    float rotation;
+};
 
-            size_t yPos = content.find("\"y\":", pos);
-            int y = std::stoi(content.substr(yPos + 4));
+bool SaveFileHandler::LoadJson(World& world, const char* data, size_t size) {
+    JsonReader reader(std::string_view(data, size));
+    std::vector<JsonTileRecord> tileRecords;
+    std::vector<BuildingRecord> buildingRecords;
 
-            size_t typePos = content.find("\"type\":", pos);
-            int type = std::stoi(content.substr(typePos + 7));
+    // Parse everything first so a malformed file leaves the world untouched
+    int x = 0, y = 0, type = 0;
+    float rotation = 0.0f;
+    unsigned seen = 0;
+    enum : unsigned { SEEN_X = 1, SEEN_Y = 2, SEEN_TYPE = 4 };
+    auto recordField = [&](std::string_view key) {
+        if (key == "x") { seen |= SEEN_X; return reader.ReadInt(x); }
+        if (key == "y") { seen |= SEEN_Y; return reader.ReadInt(y); }
+        if (key == "type") { seen |= SEEN_TYPE; return reader.ReadInt(type); }
+        if (key == "rotation") return reader.ReadNumber(rotation);
+        return reader.SkipValue();
+    };
+    auto endTile = [&]() {
+        if (seen != (SEEN_X | SEEN_Y | SEEN_TYPE)) return reader.Fail("tile needs x, y and type");
+        if (type < 0 || type > (int)TileType::TrackCorner) return reader.Fail("unknown tile type");
+        tileRecords.push_back({x, y, static_cast<TileType>(type), rotation});
+        seen = 0;
+        rotation = 0.0f;
+        return true;
+    };
+    auto endBuilding = [&]() {
+        if (seen != (SEEN_X | SEEN_Y | SEEN_TYPE)) return reader.Fail("building needs x, y and type");
+        if (type <= (int)BuildingType::None || type > (int)BuildingType::PizzaShop) return reader.Fail("unknown building type");
+        buildingRecords.push_back({x, y, type});
+        seen = 0;
+        return true;
+    };
 
-            world.PlaceBuilding(static_cast<BuildingType>(type), x, y);
+    bool ok = reader.Expect('{', "expected '{'");
+    if (ok && !reader.Consume('}')) {
+        do {
+            std::string_view key;
+            int ignored;
+            ok = reader.ReadKey(key);
+            if (!ok) break;
+            if (key == "tiles") ok = reader.ReadObjectArray(recordField, endTile);
+            else if (key == "buildings") ok = reader.ReadObjectArray(recordField, endBuilding);
+            else if (key == "rows" || key == "cols") ok = reader.ReadInt(ignored);
+            else ok = reader.SkipValue();
+        } while (ok && reader.Consume(','));
+        ok = ok && reader.Expect('}', "expected ',' or '}'");
+    }
+    ok = ok && (reader.AtEnd() || reader.Fail("trailing data after object"));
+    if (!ok) {
+        lastError = reader.ErrorString();
+        return false;
+    }
 
-            pos++;
-        }
+    loadedLineage = 0;
+    loadedSeq = 0;
+    world.Clear();
+
+    // Files list every covered cell of a multi-tile, anchors first in row-major
+    // order; the anchor stamps the footprint, so covered cells are skipped
+    for (const JsonTileRecord& record : tileRecords) {
+        if (record.x < 0 || record.x >= world.GetCols() || record.y < 0 || record.y >= world.GetRows()) continue;
+        const Tile& existing = world.GetTile(record.x, record.y);
+        if (existing.type == record.type && !existing.IsAnchor()) continue;
+        world.SetTileRaw(record.x, record.y, record.type, record.rotation);
+    }
+
+    for (const BuildingRecord& record : buildingRecords) {
+        world.PlaceBuilding(static_cast<BuildingType>(record.type), record.x, record.y);
     }
 
     world.UpdateAllConnections();
+    world.RebuildPathGraph();
+    world.RebuildTrackGraph();
 
     return true;
 }
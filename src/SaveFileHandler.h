@@ -1,11 +1,109 @@
 #pragma once
 
+#include "TileGrid.h"
+#include "Building.h"
+#include "PathGraph.h"
+#include "EditJournal.h"
 #include <string>
+#include <vector>
+#include <future>
+#include <ostream>
+#include <cstddef>
 
 class World;
 
+// Copy of everything a save writes, detached from the live world
+struct WorldSnapshot {
+    TileGrid tiles;
+    std::vector<Building> buildings;
+    std::vector<PathNode> nodes;
+    std::vector<int> edgeTargets;
+    std::vector<int> edgeCosts;
+    // Journal position folded into this snapshot (0 = not journaled)
+    uint64_t journalLineage = 0;
+    uint64_t journalSeq = 0;
+};
+
 class SaveFileHandler {
+private:
+    std::string lastError;
+    std::future<bool> pendingSave;
+    // The running save was asked for through SaveAsync (not a checkpoint)
+    bool pendingRequested = false;
+    // A SaveAsync made while another save was running; starts once that one finishes
+    bool saveQueued = false;
+    WorldSnapshot queuedSnapshot;
+    std::string queuedPath;
+    // Result of a requested save finished by WaitForSave, for the next PollSave
+    bool requestedFinished = false;
+    bool requestedResult = false;
+
+    // Journal of edits on top of the snapshot at journalSavePath
+    EditJournal journal;
+    std::string journalSavePath;
+    float syncTimer = 0.0f;
+    bool checkpointRequested = false;
+    int lastReplayed = 0;
+    // Journal position of the running save, if it is a checkpoint
+    bool pendingCheckpoint = false;
+    uint64_t pendingLineage = 0;
+    uint64_t pendingSeq = 0;
+    // Journal position stored in the last loaded snapshot
+    uint64_t loadedLineage = 0;
+    uint64_t loadedSeq = 0;
+
+    static void SaveJson(const WorldSnapshot& snapshot, std::ostream& file);
+    static void SaveBinary(const WorldSnapshot& snapshot, std::ostream& file);
+    bool LoadJson(World& world, const char* data, size_t size);
+    bool LoadBinary(World& world, const unsigned char* data, size_t size);
+    // Snapshot for filepath, carrying the journal position if it is a checkpoint
+    WorldSnapshot TakeSnapshotFor(const World& world, const std::string& filepath) const;
+    void StartSave(WorldSnapshot snapshot, const std::string& filepath, bool requested);
+    void FinishSave(bool& succeeded);
+    // Finishes the running save and any queued one
+    void WaitForSave();
+    // Writes a checkpoint for a fresh lineage and starts its empty journal
+    bool StartJournal(const World& world, const std::string& journalPath);
+
 public:
+    // Plain copies of the tile plane, buildings and graph arrays; cheap enough per frame
+    static WorldSnapshot TakeSnapshot(const World& world);
+
+    // Writes a binary snapshot, or JSON if the path ends in ".json". Files are
+    // written to a temp file, synced and renamed into place.
+    static bool Save(const WorldSnapshot& snapshot, const std::string& filepath);
     bool Save(const World& world, const std::string& filepath) const;
-    bool Load(World& world, const std::string& filepath) const;
+
+    // Writes out a save still running or queued
+    ~SaveFileHandler() { WaitForSave(); }
+
+    // Snapshots the world and saves it on a worker thread. If a save is already
+    // running, the snapshot is queued and written after it (a newer request
+    // replaces a queued one). Saving to the journaled path is a checkpoint: the
+    // journal is trimmed once it completes.
+    void SaveAsync(const World& world, const std::string& filepath);
+    bool IsSaving() const;
+    // Returns true once a save asked for through SaveAsync has finished, with
+    // its result; checkpoints finish here silently. Starts a queued save.
+    bool PollSave(bool& succeeded);
+
+    // Detects the format from the file contents; the world's graphs are ready afterwards.
+    // Loading is not journaled or recorded for undo; a world journaled by this
+    // handler is checkpointed under a new lineage once it has loaded.
+    bool Load(World& world, const std::string& filepath);
+    // Reason for the last failed Load (JSON errors carry line and column)
+    const std::string& GetLastError() const { return lastError; }
+
+    // Loads the snapshot at savePath, replays savePath + ".journal" on top and
+    // journals every further edit. Without a snapshot the current world is kept
+    // and written as the first one.
+    bool OpenWorld(World& world, const std::string& savePath);
+    // Call after replacing the world wholesale other than through Load: the old
+    // journal no longer applies, so the world is checkpointed under a new one
+    void StartNewLineage(const World& world);
+    // Per-frame journal upkeep: writes new records, syncs them periodically and
+    // starts a checkpoint when the journal grows large
+    void Autosave(const World& world, float dt);
+    // Journal records applied by the last OpenWorld
+    int GetReplayedCount() const { return lastReplayed; }
 };
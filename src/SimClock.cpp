@@ -0,0 +1,42 @@
+#include "SimClock.h"
+#include <algorithm>
+
+void SimClock::BeginFrame(float dt) {
+    double seconds = std::clamp((double)dt, 0.0, MAX_FRAME_SECONDS);
+
+    rateWindow += seconds;
+    if (rateWindow >= 1.0) {
+        ticksPerSecond = (int)(rateTicks / rateWindow + 0.5);
+        rateWindow = 0.0;
+        rateTicks = 0;
+    }
+
+    frameTicks = 0;
+    frameStart = Clock::now();
+    if (paused) {
+        frameTickLimit = 0;
+        return;
+    }
+    int speed = SPEEDS[speedIndex];
+    frameTickLimit = (int)(speed * MAX_FRAME_SECONDS * TICK_RATE);
+    // Never bank more than one frame can run
+    accumulator = std::min(accumulator + seconds * speed, frameTickLimit * TICK_SECONDS);
+}
+
+bool SimClock::Step() {
+    if (accumulator < TICK_SECONDS || frameTicks >= frameTickLimit) return false;
+    // Always run one tick so a slow tick can't stall the game outright
+    if (frameTicks > 0) {
+        std::chrono::duration<double> spent = Clock::now() - frameStart;
+        if (spent.count() >= TICK_BUDGET_SECONDS) {
+            // Out of time: the rest of the backlog is dropped, not carried over
+            accumulator = std::min(accumulator, TICK_SECONDS);
+            return false;
+        }
+    }
+    accumulator = std::max(accumulator - TICK_SECONDS, 0.0);
+    frameTicks++;
+    rateTicks++;
+    tick++;
+    return true;
+}
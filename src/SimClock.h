@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Fixed-step simulation scheduler. Frame time goes into an accumulator,
+// scaled by the game speed, and is drained in TICK_SECONDS steps, so the
+// simulation advances the same way whatever the frame rate:
+//   clock.BeginFrame(dt);
+//   while (clock.Step()) world.Tick();
+//   ... render between the last two ticks using clock.GetAlpha()
+// A frame runs at most MAX_FRAME_SECONDS of game time (times the speed), so
+// the tick rate keeps up with the speed down to 1 / MAX_FRAME_SECONDS fps, and
+// stops early once TICK_BUDGET_SECONDS of tick work are used. Time left over
+// beyond that is dropped, so slow ticks or a long stall slow the game down
+// instead of snowballing.
+class SimClock {
+public:
+    static constexpr int TICK_RATE = 60;
+    static constexpr double TICK_SECONDS = 1.0 / TICK_RATE;
+    static constexpr double MAX_FRAME_SECONDS = 0.25;
+    static constexpr double TICK_BUDGET_SECONDS = 0.010;
+
+    // Speed multipliers, in the order SpeedUp/SlowDown walk them
+    static constexpr int SPEEDS[] = { 1, 2, 4, 16 };
+    static constexpr int SPEED_COUNT = sizeof(SPEEDS) / sizeof(SPEEDS[0]);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int speedIndex = 0;
+    bool paused = false;
+    double accumulator = 0.0;
+    uint64_t tick = 0;
+
+    // Current frame
+    int frameTicks = 0;
+    int frameTickLimit = 0;
+    Clock::time_point frameStart;
+
+    // Ticks per real second, refreshed once a second
+    double rateWindow = 0.0;
+    int rateTicks = 0;
+    int ticksPerSecond = 0;
+
+public:
+    // Adds a frame's real time (seconds) and opens the frame's tick budget
+    void BeginFrame(float dt);
+    // True if another tick is due this frame; the caller then runs exactly one tick
+    bool Step();
+
+    void SetPaused(bool value) { paused = value; }
+    void TogglePause() { paused = !paused; }
+    bool IsPaused() const { return paused; }
+    void SpeedUp() { if (speedIndex < SPEED_COUNT - 1) speedIndex++; }
+    void SlowDown() { if (speedIndex > 0) speedIndex--; }
+    int GetSpeed() const { return paused ? 0 : SPEEDS[speedIndex]; }
+
+    // Fraction of the next tick already elapsed, for drawing between the
+    // previous and current tick states: prev + (curr - prev) * alpha
+    float GetAlpha() const { return (float)(accumulator / TICK_SECONDS); }
+    uint64_t GetTick() const { return tick; }
+    int GetFrameTicks() const { return frameTicks; }
+    int GetTicksPerSecond() const { return ticksPerSecond; }
+};
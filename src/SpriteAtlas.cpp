@@ -0,0 +1,113 @@
+#include "SpriteAtlas.h"
+#include <algorithm>
+#include <numeric>
+
+int SpriteAtlas::Add(Image image) {
+    entries.push_back(Entry{image});
+    return (int)entries.size() - 1;
+}
+
+// Copies src into dst at (x, y) and repeats its outer rows and columns
+// PADDING pixels outwards
+static void BlitExtruded(Image& dst, const Image& src, int x, int y) {
+    float w = (float)src.width;
+    float h = (float)src.height;
+    ImageDraw(&dst, src, { 0, 0, w, h }, { (float)x, (float)y, w, h }, WHITE);
+    for (int i = 1; i <= SpriteAtlas::PADDING; i++) {
+        float left = (float)(x - i);
+        float top = (float)(y - i);
+        float right = x + w - 1 + i;
+        float bottom = y + h - 1 + i;
+        ImageDraw(&dst, src, { 0, 0, 1, h }, { left, (float)y, 1, h }, WHITE);
+        ImageDraw(&dst, src, { w - 1, 0, 1, h }, { right, (float)y, 1, h }, WHITE);
+        ImageDraw(&dst, src, { 0, 0, w, 1 }, { (float)x, top, w, 1 }, WHITE);
+        ImageDraw(&dst, src, { 0, h - 1, w, 1 }, { (float)x, bottom, w, 1 }, WHITE);
+        for (int j = 1; j <= SpriteAtlas::PADDING; j++) {
+            float cl = (float)(x - j);
+            float cr = x + w - 1 + j;
+            ImageDraw(&dst, src, { 0, 0, 1, 1 }, { cl, top, 1, 1 }, WHITE);
+            ImageDraw(&dst, src, { w - 1, 0, 1, 1 }, { cr, top, 1, 1 }, WHITE);
+            ImageDraw(&dst, src, { 0, h - 1, 1, 1 }, { cl, bottom, 1, 1 }, WHITE);
+            ImageDraw(&dst, src, { w - 1, h - 1, 1, 1 }, { cr, bottom, 1, 1 }, WHITE);
+        }
+    }
+}
+
+// Shelf packing, tallest first: fills rows left to right and starts a new
+// page when a row no longer fits. Images over half a page would leave most of
+// their shelf empty, so they get a page of their own.
+void SpriteAtlas::Pack() {
+    std::vector<int> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return entries[a].image.height > entries[b].image.height;
+    });
+
+    std::vector<int> pageW;
+    std::vector<int> pageH;
+    int page = -1;
+    int x = 0, y = 0, shelfH = 0;
+    for (int idx : order) {
+        Entry& entry = entries[idx];
+        int cellW = entry.image.width + 2 * PADDING;
+        int cellH = entry.image.height + 2 * PADDING;
+
+        if (cellW > PAGE_SIZE / 2 || cellH > PAGE_SIZE / 2) {
+            entry.page = (int)pageW.size();
+            entry.rect = { (float)PADDING, (float)PADDING, (float)entry.image.width, (float)entry.image.height };
+            pageW.push_back(cellW);
+            pageH.push_back(cellH);
+            continue;
+        }
+
+        if (page >= 0 && x + cellW > PAGE_SIZE) {
+            y += shelfH;
+            x = 0;
+            shelfH = 0;
+        }
+        if (page < 0 || y + cellH > PAGE_SIZE) {
+            page = (int)pageW.size();
+            pageW.push_back(0);
+            pageH.push_back(0);
+            x = y = shelfH = 0;
+        }
+
+        entry.page = page;
+        entry.rect = { (float)(x + PADDING), (float)(y + PADDING), (float)entry.image.width, (float)entry.image.height };
+        x += cellW;
+        shelfH = std::max(shelfH, cellH);
+        pageW[page] = std::max(pageW[page], x);
+        pageH[page] = std::max(pageH[page], y + cellH);
+    }
+
+    for (size_t p = 0; p < pageW.size(); p++) {
+        Image atlas = GenImageColor(pageW[p], pageH[p], BLANK);
+        for (const Entry& entry : entries) {
+            if (entry.page != (int)p) continue;
+            BlitExtruded(atlas, entry.image, (int)entry.rect.x, (int)entry.rect.y);
+        }
+        pages.push_back(atlas);
+    }
+
+    for (Entry& entry : entries) {
+        UnloadImage(entry.image);
+        entry.image = Image{};
+    }
+}
+
+std::vector<Image> SpriteAtlas::TakePages() {
+    std::vector<Image> taken;
+    taken.swap(pages);
+    return taken;
+}
+
+void SpriteAtlas::Unload() {
+    for (Image& page : pages) {
+        UnloadImage(page);
+    }
+    for (Entry& entry : entries) {
+        if (entry.image.data) UnloadImage(entry.image);
+    }
+    pages.clear();
+    entries.clear();
+}
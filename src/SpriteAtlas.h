@@ -0,0 +1,49 @@
+#pragma once
+
+#include "raylib.h"
+#include <vector>
+
+// A sprite's page texture and its sub-rectangle on that page
+struct AtlasSprite {
+    Texture2D texture = {};  // id 0 = no sprite
+    Rectangle source = {};
+
+    bool IsValid() const { return texture.id != 0; }
+};
+
+// Packs sprite images into as few pages as possible, so runs of sprite draws
+// keep the same texture bound and raylib can batch them into one draw call.
+// Sprites are separated by a border that repeats their edge pixels, so
+// rotated or scaled draws never sample a neighbour. CPU only: the pages are
+// uploaded by AssetPack, or baked into a pack file ahead of time.
+class SpriteAtlas {
+private:
+    struct Entry {
+        Image image;
+        int page = -1;
+        Rectangle rect = {};
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Image> pages;
+
+public:
+    static const int PAGE_SIZE = 2048;
+    static const int PADDING = 1;
+
+    SpriteAtlas() = default;
+    ~SpriteAtlas() { Unload(); }
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+    // Queues an image (taking ownership) and returns its handle
+    int Add(Image image);
+    // Composes the queued images into RGBA8 pages and frees them
+    void Pack();
+    // Hands the page images to the caller, who unloads them
+    std::vector<Image> TakePages();
+    int GetPage(int handle) const { return entries[handle].page; }
+    Rectangle GetRect(int handle) const { return entries[handle].rect; }
+    int GetCount() const { return (int)entries.size(); }
+    void Unload();
+};
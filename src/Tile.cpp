@@ -1,4 +1,5 @@
 #include "Tile.h"
+#include <cmath>
 
 const char* GetTileName(TileType type) {
     switch (type) {
@@ -11,16 +12,6 @@ const char* GetTileName(TileType type) {
     }
 }
 
-Color GetTileColor(TileType type) {
-    switch (type) {
-        case TileType::Path:  return LIME;
-        case TileType::Road:  return GRAY;
-        case TileType::Track: return BROWN;
-        case TileType::TrackCorner: return BROWN;
-        default:              return BLANK;
-    }
-}
-
 int GetTileWidth(TileType type) {
     switch (type) {
         case TileType::Road: return 2;
@@ -37,6 +28,16 @@ int GetTileHeight(TileType type) {
     }
 }
 
+uint8_t DegreesToQuarterTurns(float degrees) {
+    int turns = (int)lroundf(degrees / 90.0f) % 4;
+    if (turns < 0) turns += 4;
+    return (uint8_t)turns;
+}
+
+float QuarterTurnsToDegrees(uint8_t quarterTurns) {
+    return (quarterTurns & 3) * 90.0f;
+}
+
 int GetTileTextureKey(TileType type, uint8_t connections) {
     return (static_cast<int>(type) << 8) | connections;
 }
@@ -114,50 +115,6 @@ bool CanTilesConnect(TileType a, TileType b) {
     return false;
 }
 
-int TileTextures::GetShapeKey(TileType type, TileShape shape) const {
-    return (static_cast<int>(type) << 4) | static_cast<int>(shape);
-}
-
-void TileTextures::Load() {
-    // Path (sidewalk) - single texture
-    textures[GetShapeKey(TileType::Path, TileShape::Single)] = LoadTexture("resources/sidewalk.png");
-
-    // Road base textures (one per shape, rotated as needed)
-    textures[GetShapeKey(TileType::Road, TileShape::Straight)] = LoadTexture("resources/road2x2Horizontal.png");
-    textures[GetShapeKey(TileType::Road, TileShape::Corner)] = LoadTexture("resources/road2x2TurnRightDown.png");
-    textures[GetShapeKey(TileType::Road, TileShape::TJunction)] = LoadTexture("resources/road2x2TDown.png");
-    textures[GetShapeKey(TileType::Road, TileShape::Cross)] = LoadTexture("resources/road2x2Cross.png");
-    textures[GetShapeKey(TileType::Road, TileShape::DeadEnd)] = LoadTexture("resources/road2x2EndDown.png");
-
-    // Track base textures
-    textures[GetShapeKey(TileType::Track, TileShape::Straight)] = LoadTexture("resources/railHorizontal.png");
-    textures[GetShapeKey(TileType::TrackCorner, TileShape::Corner)] = LoadTexture("resources/railTurnRightDown.png");
-
-    loaded = true;
-}
-
-void TileTextures::Unload() {
-    for (auto& [key, texture] : textures) {
-        UnloadTexture(texture);
-    }
-    textures.clear();
-    loaded = false;
-}
-
-bool TileTextures::HasTexture(TileType type, TileShape shape) const {
-    return textures.find(GetShapeKey(type, shape)) != textures.end();
-}
-
-Texture2D TileTextures::Get(TileType type, TileShape shape) const {
-    int key = GetShapeKey(type, shape);
-    auto it = textures.find(key);
-    if (it != textures.end()) {
-        return it->second;
-    }
-    // Fallback: try straight shape
-    it = textures.find(GetShapeKey(type, TileShape::Straight));
-    if (it != textures.end()) {
-        return it->second;
-    }
-    return Texture2D{};
+bool UsesAutoConnections(TileType type) {
+    return type == TileType::Road;
 }
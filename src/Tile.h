@@ -1,7 +1,5 @@
 #pragma once
 
-#include "raylib.h"
-#include <unordered_map>
 #include <cstdint>
 
 const int TILE_SIZE = 16;
@@ -15,37 +13,52 @@ enum TileConnection : uint8_t {
     CONN_LEFT  = 8
 };
 
-enum class TileType {
+enum class TileType : uint8_t {
     Empty,
     Path,
     Road,
     Track,
     TrackCorner
 };
+const int TILE_TYPE_COUNT = 5;
 
 // Get tile dimensions (most tiles are 1x1, roads are 2x2)
 int GetTileWidth(TileType type);
 int GetTileHeight(TileType type);
+// Largest footprint side of any tile type (track corners are 3x3)
+const int MAX_TILE_SPAN = 3;
 
+// Packed into 4 bytes so full-grid passes stay cache friendly
 struct Tile {
     TileType type = TileType::Empty;
     uint8_t connections = CONN_NONE;
-    float rotation = 0.0f;  // Manual rotation for track pieces
-    // For multi-tile types: true if this is the anchor (top-left), false if part of larger tile
-    bool isAnchor = true;
-    // For non-anchor cells: offset to the anchor cell
-    int8_t anchorOffsetX = 0;
-    int8_t anchorOffsetY = 0;
+    uint8_t rotation = 0;  // Manual rotation for track pieces, in quarter turns (0-3)
+    // For multi-tile types: distance back to the anchor (top-left) cell.
+    // Low nibble is X, high nibble is Y; zero means this cell is the anchor.
+    uint8_t anchorOffset = 0;
+
+    bool IsAnchor() const { return anchorOffset == 0; }
+    int AnchorOffsetX() const { return -(anchorOffset & 0x0F); }
+    int AnchorOffsetY() const { return -(anchorOffset >> 4); }
+    void SetAnchorOffset(int dx, int dy) { anchorOffset = (uint8_t)((dy << 4) | dx); }
 };
 
+static_assert(sizeof(Tile) == 4, "Tile must stay packed");
+
+// Track rotation is stored in quarter turns; rendering and save files use degrees
+uint8_t DegreesToQuarterTurns(float degrees);
+float QuarterTurnsToDegrees(uint8_t quarterTurns);
+
 const char* GetTileName(TileType type);
-Color GetTileColor(TileType type);
 
 // Get texture key based on type and connections
 int GetTileTextureKey(TileType type, uint8_t connections);
 
 // Check if two tile types can connect to each other
 bool CanTilesConnect(TileType a, TileType b);
+// True for types whose anchors take their connections from their neighbours;
+// paths don't store connections and track uses its manual rotation
+bool UsesAutoConnections(TileType type);
 
 // Shape types for tiles that can be rotated
 enum class TileShape {
@@ -56,24 +69,8 @@ enum class TileShape {
     Cross,      // Connects all 4 sides
     DeadEnd     // Connects 1 side
 };
+const int TILE_SHAPE_COUNT = 6;
 
 // Get the shape and rotation for a given connection pattern
 TileShape GetTileShape(uint8_t connections);
 float GetTileRotation(uint8_t connections);
-
-class TileTextures {
-private:
-    // Base textures for each tile type and shape
-    // Key: (TileType << 4) | TileShape
-    std::unordered_map<int, Texture2D> textures;
-    bool loaded = false;
-
-    int GetShapeKey(TileType type, TileShape shape) const;
-
-public:
-    void Load();
-    void Unload();
-    bool HasTexture(TileType type, TileShape shape) const;
-    Texture2D Get(TileType type, TileShape shape) const;
-    bool IsLoaded() const { return loaded; }
-};
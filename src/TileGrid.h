@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Tile.h"
+#include "ChunkedGrid.h"
+
+// Sparse tile storage: only chunks with something built in them are allocated
+class TileGrid : public ChunkedGrid<Tile> {
+public:
+    TileGrid() = default;
+    TileGrid(int rows, int cols) : ChunkedGrid<Tile>(rows, cols) {}
+
+    TileType TypeAt(int x, int y) const { return Get(x, y).type; }
+};
@@ -0,0 +1,184 @@
+#include "TileLayerCache.h"
+#include <algorithm>
+
+// Draws one tile anchored at pos (top-left, 1x scale)
+static void DrawTile(const Tile& tile, Vector2 pos, TileTextures& textures) {
+    int w = GetTileWidth(tile.type);
+    int h = GetTileHeight(tile.type);
+    float renderW = (float)(TILE_SIZE * w);
+    float renderH = (float)(TILE_SIZE * h);
+
+    // Get shape and rotation
+    TileShape shape;
+    float rotation;
+    if (tile.type == TileType::Track) {
+        shape = TileShape::Straight;
+        rotation = QuarterTurnsToDegrees(tile.rotation);
+    } else if (tile.type == TileType::TrackCorner) {
+        shape = TileShape::Corner;
+        rotation = QuarterTurnsToDegrees(tile.rotation);
+    } else if (tile.type == TileType::Path) {
+        shape = TileShape::Single;
+        rotation = 0.0f;
+    } else {
+        shape = GetTileShape(tile.connections);
+        rotation = GetTileRotation(tile.connections);
+    }
+
+    const AtlasSprite& sprite = textures.Get(tile.type, shape);
+    if (sprite.IsValid()) {
+        // For rotation, we need to position dest at center and use origin
+        float centerX = pos.x + renderW / 2;
+        float centerY = pos.y + renderH / 2;
+        Rectangle dest = { centerX, centerY, renderW, renderH };
+        Vector2 origin = { renderW / 2, renderH / 2 };
+        DrawTexturePro(sprite.texture, sprite.source, dest, origin, rotation, WHITE);
+    } else {
+        Color color = GetTileColor(tile.type);
+        DrawRectangle((int)pos.x, (int)pos.y, (int)renderW, (int)renderH, color);
+    }
+}
+
+void TileLayerCache::Resize(int newRows, int newCols) {
+    rows = newRows;
+    cols = newCols;
+    chunkRows = (rows + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    chunkCols = (cols + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    size_t count = (size_t)chunkRows * chunkCols;
+    chunkSlot.assign(count, -1);
+    chunkDirty.assign(count, 1);
+    chunkEmpty.assign(count, 0);
+    for (Slot& slot : slots) slot.chunk = -1;
+}
+
+void TileLayerCache::MarkDirty(int x0, int y0, int x1, int y1) {
+    int cx0 = std::max(x0, 0) / CHUNK_CELLS;
+    int cy0 = std::max(y0, 0) / CHUNK_CELLS;
+    int cx1 = std::min(x1, cols - 1) / CHUNK_CELLS;
+    int cy1 = std::min(y1, rows - 1) / CHUNK_CELLS;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            chunkDirty[(size_t)cy * chunkCols + cx] = 1;
+        }
+    }
+}
+
+void TileLayerCache::MarkAllDirty() {
+    std::fill(chunkDirty.begin(), chunkDirty.end(), 1);
+}
+
+int TileLayerCache::AcquireSlot() {
+    if ((int)slots.size() < POOL_SIZE) {
+        slots.push_back(Slot{LoadRenderTexture(CHUNK_PIXELS, CHUNK_PIXELS), -1, 0});
+        return (int)slots.size() - 1;
+    }
+
+    // Recycle the slot that has been off-screen longest
+    int best = -1;
+    for (int i = 0; i < (int)slots.size(); i++) {
+        if (slots[i].lastUsed == frame) continue;
+        if (best < 0 || slots[i].lastUsed < slots[best].lastUsed) best = i;
+    }
+    if (best < 0) {
+        slots.push_back(Slot{LoadRenderTexture(CHUNK_PIXELS, CHUNK_PIXELS), -1, 0});
+        return (int)slots.size() - 1;
+    }
+    if (slots[best].chunk >= 0) chunkSlot[slots[best].chunk] = -1;
+    return best;
+}
+
+void TileLayerCache::Redraw(int chunk, const TileGrid& tiles, TileTextures& textures) {
+    int originX = (chunk % chunkCols) * CHUNK_CELLS;
+    int originY = (chunk / chunkCols) * CHUNK_CELLS;
+
+    // Pieces anchored just above/left of the chunk can overlap into it; the
+    // render target clips whatever falls outside
+    int x0 = std::max(originX - (MAX_TILE_SPAN - 1), 0);
+    int y0 = std::max(originY - (MAX_TILE_SPAN - 1), 0);
+    int x1 = std::min(originX + CHUNK_CELLS, cols) - 1;
+    int y1 = std::min(originY + CHUNK_CELLS, rows) - 1;
+
+    int drawn = 0;
+    BeginTextureMode(slots[chunkSlot[chunk]].target);
+    ClearBackground(BLANK);
+    for (int y = y0; y <= y1; y++) {
+        tilesVisited += x1 - x0 + 1;
+        for (int x = x0; x <= x1; x++) {
+            const Tile& tile = tiles.At(x, y);
+            if (tile.type == TileType::Empty || !tile.IsAnchor()) continue;
+            Vector2 pos = { (float)((x - originX) * TILE_SIZE), (float)((y - originY) * TILE_SIZE) };
+            DrawTile(tile, pos, textures);
+            drawn++;
+        }
+    }
+    EndTextureMode();
+
+    tilesDrawn += drawn;
+    chunkEmpty[chunk] = drawn == 0;
+    chunkDirty[chunk] = 0;
+    chunksRedrawn++;
+}
+
+void TileLayerCache::Update(const TileGrid& tiles, const GameCamera& camera, TileTextures& textures) {
+    frame++;
+    chunksRedrawn = 0;
+    tilesVisited = 0;
+    tilesDrawn = 0;
+
+    int x0, y0, x1, y1;
+    if (!camera.VisibleCells(rows, cols, 0, x0, y0, x1, y1)) {
+        visX1 = -1;
+        return;
+    }
+    visX0 = x0 / CHUNK_CELLS;
+    visY0 = y0 / CHUNK_CELLS;
+    visX1 = x1 / CHUNK_CELLS;
+    visY1 = y1 / CHUNK_CELLS;
+
+    for (int cy = visY0; cy <= visY1; cy++) {
+        for (int cx = visX0; cx <= visX1; cx++) {
+            int chunk = cy * chunkCols + cx;
+            int slot = chunkSlot[chunk];
+            // Nothing stored under this chunk (or the pieces overlapping into it): no texture needed
+            if (slot < 0 && !tiles.HasChunksIn(cx * CHUNK_CELLS - (MAX_TILE_SPAN - 1), cy * CHUNK_CELLS - (MAX_TILE_SPAN - 1),
+                                               (cx + 1) * CHUNK_CELLS - 1, (cy + 1) * CHUNK_CELLS - 1)) {
+                continue;
+            }
+            if (slot < 0) {
+                slot = AcquireSlot();
+                slots[slot].chunk = chunk;
+                chunkSlot[chunk] = slot;
+                chunkDirty[chunk] = 1;
+            }
+            slots[slot].lastUsed = frame;
+            if (chunkDirty[chunk]) Redraw(chunk, tiles, textures);
+        }
+    }
+}
+
+void TileLayerCache::Draw(const GameCamera& camera) {
+    chunksDrawn = 0;
+    float size = CHUNK_PIXELS * camera.zoom;
+    // Render textures are stored bottom-up, hence the negative source height
+    Rectangle source = { 0, 0, (float)CHUNK_PIXELS, -(float)CHUNK_PIXELS };
+
+    for (int cy = visY0; cy <= visY1; cy++) {
+        for (int cx = visX0; cx <= visX1; cx++) {
+            int chunk = cy * chunkCols + cx;
+            int slot = chunkSlot[chunk];
+            if (slot < 0 || chunkEmpty[chunk]) continue;
+            Vector2 pos = WorldToScreen(cx * CHUNK_CELLS, cy * CHUNK_CELLS, camera.offset, camera.zoom);
+            Rectangle dest = { pos.x, pos.y, size, size };
+            DrawTexturePro(slots[slot].target.texture, source, dest, {0, 0}, 0.0f, WHITE);
+            chunksDrawn++;
+        }
+    }
+}
+
+void TileLayerCache::Unload() {
+    for (Slot& slot : slots) {
+        UnloadRenderTexture(slot.target);
+    }
+    slots.clear();
+    std::fill(chunkSlot.begin(), chunkSlot.end(), -1);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "raylib.h"
+#include "Tile.h"
+#include "TileTextures.h"
+#include "TileGrid.h"
+#include "Camera.h"
+#include <vector>
+#include <cstdint>
+
+// The static tile layer pre-rendered in CHUNK_CELLS x CHUNK_CELLS chunks. Each
+// visible chunk owns an off-screen render texture at 1x scale that is only
+// redrawn after an edit marks it dirty, so a frame draws one quad per chunk.
+// Textures are pooled and recycled least-recently-visible first, so memory
+// follows the screen size rather than the map size.
+class TileLayerCache {
+private:
+    struct Slot {
+        RenderTexture2D target;
+        int chunk = -1;
+        uint32_t lastUsed = 0;
+    };
+
+    int rows = 0;
+    int cols = 0;
+    int chunkRows = 0;
+    int chunkCols = 0;
+    std::vector<int> chunkSlot;        // pool slot holding the chunk, or -1
+    std::vector<uint8_t> chunkDirty;
+    std::vector<uint8_t> chunkEmpty;   // nothing to draw as of the last redraw
+    std::vector<Slot> slots;
+    uint32_t frame = 0;
+
+    // Visible chunk range from the last Update
+    int visX0 = 0, visY0 = 0, visX1 = -1, visY1 = -1;
+
+    int chunksDrawn = 0;
+    int chunksRedrawn = 0;
+    int tilesVisited = 0;
+    int tilesDrawn = 0;
+
+    int AcquireSlot();
+    void Redraw(int chunk, const TileGrid& tiles, TileTextures& textures);
+
+public:
+    static const int CHUNK_CELLS = 32;
+    static const int CHUNK_PIXELS = CHUNK_CELLS * TILE_SIZE;
+    // Textures kept before recycling starts; grows if more chunks are on screen at once
+    static const int POOL_SIZE = 48;
+
+    // Sets the map size; every chunk starts dirty
+    void Resize(int rows, int cols);
+    // Cell rectangle (inclusive) whose pixels may have changed
+    void MarkDirty(int x0, int y0, int x1, int y1);
+    void MarkAllDirty();
+
+    // Redraws dirty visible chunks; call outside BeginDrawing/EndDrawing
+    void Update(const TileGrid& tiles, const GameCamera& camera, TileTextures& textures);
+    // One textured quad per visible non-empty chunk
+    void Draw(const GameCamera& camera);
+    // Releases the render textures; must run before CloseWindow
+    void Unload();
+
+    int GetChunksDrawn() const { return chunksDrawn; }
+    int GetChunksRedrawn() const { return chunksRedrawn; }
+    int GetTilesVisited() const { return tilesVisited; }
+    int GetTilesDrawn() const { return tilesDrawn; }
+};
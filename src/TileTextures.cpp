@@ -0,0 +1,62 @@
+#include "TileTextures.h"
+#include "AssetPack.h"
+
+Color GetTileColor(TileType type) {
+    switch (type) {
+        case TileType::Path:  return LIME;
+        case TileType::Road:  return GRAY;
+        case TileType::Track: return BROWN;
+        case TileType::TrackCorner: return BROWN;
+        default:              return BLANK;
+    }
+}
+
+void TileTextures::Load(const AssetPack& assets) {
+    auto set = [&](TileType type, TileShape shape, const char* name) {
+        sprites[static_cast<int>(type)][static_cast<int>(shape)] = assets.Get(name);
+    };
+
+    // Path (sidewalk) - single texture
+    set(TileType::Path, TileShape::Single, "sidewalk");
+
+    // Road base textures (one per shape, rotated as needed)
+    set(TileType::Road, TileShape::Straight, "road2x2Horizontal");
+    set(TileType::Road, TileShape::Corner, "road2x2TurnRightDown");
+    set(TileType::Road, TileShape::TJunction, "road2x2TDown");
+    set(TileType::Road, TileShape::Cross, "road2x2Cross");
+    set(TileType::Road, TileShape::DeadEnd, "road2x2EndDown");
+
+    // Track base textures
+    set(TileType::Track, TileShape::Straight, "railHorizontal");
+    set(TileType::TrackCorner, TileShape::Corner, "railTurnRightDown");
+
+    // Shapes without their own sprite draw with the type's straight sprite, or
+    // failing that any sprite of the type, so every pair resolves to a texture
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        if (static_cast<TileType>(t) == TileType::Empty) continue;
+        const AtlasSprite* fallback = nullptr;
+        if (sprites[t][static_cast<int>(TileShape::Straight)].IsValid()) {
+            fallback = &sprites[t][static_cast<int>(TileShape::Straight)];
+        }
+        for (int s = 0; s < TILE_SHAPE_COUNT && !fallback; s++) {
+            if (sprites[t][s].IsValid()) fallback = &sprites[t][s];
+        }
+        if (!fallback) {
+            TraceLog(LOG_WARNING, "No sprite for %s tiles, drawing them as flat colour",
+                     GetTileName(static_cast<TileType>(t)));
+            continue;
+        }
+        for (int s = 0; s < TILE_SHAPE_COUNT; s++) {
+            if (!sprites[t][s].IsValid()) sprites[t][s] = *fallback;
+        }
+    }
+
+    loaded = true;
+}
+
+void TileTextures::Unload() {
+    for (auto& row : sprites) {
+        for (AtlasSprite& sprite : row) sprite = AtlasSprite{};
+    }
+    loaded = false;
+}
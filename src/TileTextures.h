@@ -0,0 +1,28 @@
+#pragma once
+
+#include "raylib.h"
+#include "Tile.h"
+#include "SpriteAtlas.h"
+
+// Fallback fill for tiles without a sprite
+Color GetTileColor(TileType type);
+
+class AssetPack;
+
+class TileTextures {
+private:
+    // Base sprites from the asset pack in a dense [type][shape] table; shapes
+    // without a sprite of their own hold the type's fallback
+    AtlasSprite sprites[TILE_TYPE_COUNT][TILE_SHAPE_COUNT];
+    bool loaded = false;
+
+public:
+    // Looks the sprites up once; the pack owns their textures
+    void Load(const AssetPack& assets);
+    void Unload();
+    bool HasTexture(TileType type, TileShape shape) const { return Get(type, shape).IsValid(); }
+    const AtlasSprite& Get(TileType type, TileShape shape) const {
+        return sprites[static_cast<int>(type)][static_cast<int>(shape)];
+    }
+    bool IsLoaded() const { return loaded; }
+};
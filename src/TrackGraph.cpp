@@ -0,0 +1,176 @@
+#include "TrackGraph.h"
+
+static bool IsTrack(TileType type) {
+    return type == TileType::Track || type == TileType::TrackCorner;
+}
+
+static int DirX(uint8_t dir) { return dir == CONN_RIGHT ? 1 : (dir == CONN_LEFT ? -1 : 0); }
+static int DirY(uint8_t dir) { return dir == CONN_DOWN ? 1 : (dir == CONN_UP ? -1 : 0); }
+
+// Quarter turn clockwise: UP -> RIGHT -> DOWN -> LEFT -> UP
+static uint8_t RotateDir(uint8_t dir, int quarterTurns) {
+    for (int i = 0; i < quarterTurns; i++) {
+        dir = (dir == CONN_LEFT) ? (uint8_t)CONN_UP : (uint8_t)(dir << 1);
+    }
+    return dir;
+}
+
+int GetTrackPorts(TileType type, uint8_t quarterTurns, TrackPort ports[2]) {
+    // Unrotated sprites: railHorizontal runs left-right, railTurnRightDown
+    // leaves the top-right cell to the right and the bottom-left cell downwards
+    int size;
+    if (type == TileType::Track) {
+        ports[0] = {0, 0, CONN_LEFT};
+        ports[1] = {0, 0, CONN_RIGHT};
+        size = 1;
+    } else if (type == TileType::TrackCorner) {
+        ports[0] = {2, 0, CONN_RIGHT};
+        ports[1] = {0, 2, CONN_DOWN};
+        size = 3;
+    } else {
+        return 0;
+    }
+
+    // Rotate clockwise about the footprint centre, matching DrawTexturePro
+    for (int p = 0; p < 2; p++) {
+        for (int i = 0; i < (quarterTurns & 3); i++) {
+            int x = ports[p].x;
+            ports[p].x = size - 1 - ports[p].y;
+            ports[p].y = x;
+        }
+        ports[p].dir = RotateDir(ports[p].dir, quarterTurns & 3);
+    }
+    return 2;
+}
+
+int TrackGraph::PiecePorts(const TileGrid& tiles, int ax, int ay, TrackPort ports[2]) const {
+    const Tile& tile = tiles.At(ax, ay);
+    int count = GetTrackPorts(tile.type, tile.rotation, ports);
+    for (int p = 0; p < count; p++) {
+        ports[p].x += ax;
+        ports[p].y += ay;
+    }
+    return count;
+}
+
+int TrackGraph::MatchPort(const TileGrid& tiles, const TrackPort& port, int& ax, int& ay) const {
+    int nx = port.x + DirX(port.dir);
+    int ny = port.y + DirY(port.dir);
+    const Tile& neighbor = tiles.Get(nx, ny);
+    if (!IsTrack(neighbor.type)) return -1;
+
+    ax = nx + neighbor.AnchorOffsetX();
+    ay = ny + neighbor.AnchorOffsetY();
+    uint8_t facing = RotateDir(port.dir, 2);
+
+    TrackPort ports[2];
+    int count = PiecePorts(tiles, ax, ay, ports);
+    for (int q = 0; q < count; q++) {
+        if (ports[q].x == nx && ports[q].y == ny && ports[q].dir == facing) return q;
+    }
+    return -1;
+}
+
+bool TrackGraph::IsNodePiece(const TileGrid& tiles, int ax, int ay) const {
+    if (tiles.At(ax, ay).type != TileType::Track) return true;
+
+    TrackPort ports[2];
+    int count = PiecePorts(tiles, ax, ay, ports);
+    for (int p = 0; p < count; p++) {
+        int nx, ny;
+        if (MatchPort(tiles, ports[p], nx, ny) < 0) return true;
+    }
+    return false;
+}
+
+// Single row-major pass. Every straight piece with both ends linked extends the
+// run it continues (tracked per row for horizontal runs, per column for vertical
+// ones); a run is closed when the next piece is a node. Edges are recorded by
+// anchor position and resolved to node indices once all nodes are known.
+void TrackGraph::Build(const TileGrid& tiles) {
+    int rows = tiles.GetRows();
+    int cols = tiles.GetCols();
+    nodes.clear();
+    posToNode.clear();
+    maxCols = cols;
+
+    struct RunStart {
+        int key = -1;
+        int port = -1;
+        int length = 0;
+    };
+    struct PendingEdge {
+        int keyA, portA, keyB, portB, length;
+    };
+    std::vector<RunStart> columnRuns(cols);
+    std::vector<PendingEdge> pending;
+
+    // Row-major, skipping unallocated chunks (they hold no track)
+    for (int y = 0; y < rows; y++) {
+        RunStart rowRun;
+        for (int cx = 0; cx < tiles.GetChunkCols(); cx++) {
+            const Tile* row = tiles.ChunkRow(cx, y);
+            if (!row) continue;
+            int x0 = cx * TileGrid::CHUNK_SIZE;
+            int x1 = std::min(x0 + TileGrid::CHUNK_SIZE, cols);
+            for (int x = x0; x < x1; x++) {
+                const Tile& tile = row[x - x0];
+                if (!IsTrack(tile.type) || !tile.IsAnchor()) continue;
+
+                TrackPort ports[2];
+                int count = PiecePorts(tiles, x, y, ports);
+
+                // Neighbouring piece (anchor and port) behind each of our ports
+                int linkX[2], linkY[2], linkPort[2];
+                bool isNode = tile.type != TileType::Track;
+                for (int p = 0; p < count; p++) {
+                    linkPort[p] = MatchPort(tiles, ports[p], linkX[p], linkY[p]);
+                    if (linkPort[p] < 0) isNode = true;
+                }
+
+                if (isNode) {
+                    posToNode[PosKey(x, y)] = (int)nodes.size();
+                    TrackNode node{x, y, tile.type, count, {ports[0], ports[1]}, {}};
+                    nodes.push_back(node);
+
+                    // Directly touching nodes are joined by a zero-length edge
+                    for (int p = 0; p < count; p++) {
+                        if (linkPort[p] >= 0 && IsNodePiece(tiles, linkX[p], linkY[p])) {
+                            pending.push_back({PosKey(x, y), p, PosKey(linkX[p], linkY[p]), linkPort[p], 0});
+                        }
+                    }
+                    continue;
+                }
+
+                // Straight piece inside a run: 'back' faces left/up (already scanned), 'ahead' right/down
+                bool horizontal = ports[0].dir == CONN_LEFT || ports[0].dir == CONN_RIGHT;
+                int back = (ports[0].dir == CONN_LEFT || ports[0].dir == CONN_UP) ? 0 : 1;
+                int ahead = 1 - back;
+                RunStart& run = horizontal ? rowRun : columnRuns[x];
+
+                if (IsNodePiece(tiles, linkX[back], linkY[back])) {
+                    run = {PosKey(linkX[back], linkY[back]), linkPort[back], 1};
+                } else {
+                    run.length++;
+                }
+
+                if (IsNodePiece(tiles, linkX[ahead], linkY[ahead])) {
+                    pending.push_back({run.key, run.port, PosKey(linkX[ahead], linkY[ahead]), linkPort[ahead], run.length});
+                }
+            }
+        }
+    }
+
+    for (const PendingEdge& e : pending) {
+        int a = posToNode[e.keyA];
+        int b = posToNode[e.keyB];
+        nodes[a].edges[e.portA] = {b, e.portB, e.length};
+        nodes[b].edges[e.portB] = {a, e.portA, e.length};
+    }
+}
+
+int TrackGraph::FindNode(int x, int y) const {
+    auto it = posToNode.find(PosKey(x, y));
+    if (it != posToNode.end()) return it->second;
+    return -1;
+}
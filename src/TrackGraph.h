@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Tile.h"
+#include "TileGrid.h"
+#include <vector>
+#include <unordered_map>
+
+// Where a track piece meets its neighbour: a cell of the piece and the
+// direction (TileConnection bit) pointing out of it
+struct TrackPort {
+    int x, y;
+    uint8_t dir;
+};
+
+// Ports of a piece anchored at (0, 0) with the given rotation; returns the port count
+int GetTrackPorts(TileType type, uint8_t quarterTurns, TrackPort ports[2]);
+
+struct TrackEdge {
+    int target = -1;      // Node index, -1 if the port is open
+    int targetPort = -1;  // Port on the target node the edge arrives at
+    int length = 0;       // Straight track tiles between the two pieces
+};
+
+// Corners and pieces with an open end; straight runs between them become edges
+struct TrackNode {
+    int x, y;             // Anchor cell
+    TileType type;
+    int portCount;
+    TrackPort ports[2];   // World coordinates
+    TrackEdge edges[2];   // One per port
+};
+
+class TrackGraph {
+private:
+    std::vector<TrackNode> nodes;
+    std::unordered_map<int, int> posToNode;
+    int maxCols = 0;
+
+    int PosKey(int x, int y) const { return y * maxCols + x; }
+
+    // Ports of the piece anchored at (ax, ay), in world coordinates
+    int PiecePorts(const TileGrid& tiles, int ax, int ay, TrackPort ports[2]) const;
+    // Finds the piece port facing 'port' from the neighbouring cell; returns its index or -1
+    int MatchPort(const TileGrid& tiles, const TrackPort& port, int& ax, int& ay) const;
+    bool IsNodePiece(const TileGrid& tiles, int ax, int ay) const;
+
+public:
+    void Build(const TileGrid& tiles);
+    const std::vector<TrackNode>& GetNodes() const { return nodes; }
+    int FindNode(int x, int y) const;
+};
@@ -0,0 +1,65 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threadCount) {
+    if (threadCount <= 0) threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < threadCount; i++) workers.emplace_back([this] { WorkerLoop(); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void WorkerPool::Drain(const std::function<void(int)>& fn, int count) {
+    for (int i = next++; i < count; i = next++) fn(i);
+}
+
+void WorkerPool::WorkerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(int)>* fn;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            fn = job;
+            count = jobCount;
+        }
+        Drain(*fn, count);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // Run waits for every worker, so none can miss a job or see one twice
+            if (--active == 0) done.notify_one();
+        }
+    }
+}
+
+void WorkerPool::Run(int count, const std::function<void(int)>& fn) {
+    if (count <= 0) return;
+    if (workers.empty() || count == 1) {
+        for (int i = 0; i < count; i++) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        next = 0;
+        active = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+    Drain(fn, count);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return active == 0; });
+    job = nullptr;
+}
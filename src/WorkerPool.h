@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads for splitting one job into independent tasks:
+//   pool.Run(count, [&](int i) { ... task i ... });
+// Run blocks until every task is done; the calling thread works on tasks too,
+// so a pool of N threads starts N - 1 workers. Tasks are handed out in index
+// order but finish in any order, so callers write results per task and merge
+// them afterwards. Run must not be called from several threads at once.
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Current job, published under the mutex
+    const std::function<void(int)>* job = nullptr;
+    int jobCount = 0;
+    uint64_t generation = 0;
+    int active = 0;  // workers yet to finish the current job
+    bool stopping = false;
+    std::atomic<int> next{0};
+
+    void WorkerLoop();
+    void Drain(const std::function<void(int)>& fn, int count);
+
+public:
+    // 0 uses one thread per hardware thread
+    explicit WorkerPool(int threadCount = 0);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Threads that run tasks, counting the caller
+    int GetThreadCount() const { return (int)workers.size() + 1; }
+
+    void Run(int count, const std::function<void(int)>& fn);
+};
@@ -1,76 +1,180 @@
 #include "World.h"
+#include "EditJournal.h"
+#include "EditHistory.h"
+#include "FrameProfiler.h"
+#include "ConnectionPlanes.h"
 #include <algorithm>
 
-World::World(int rows, int cols) : rows(rows), cols(cols) {
-    tiles.resize(rows, std::vector<Tile>(cols));
+World::World(int rows, int cols)
+    : rows(rows), cols(cols), tiles(rows, cols), buildingAt(rows, cols, -1) {
+    pathGraph.Build(tiles);
+    RebuildTrackGraph();
 }
 
 void World::Clear() {
-    for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            tiles[y][x] = Tile{};
-        }
-    }
+    tiles.Clear();
     buildings.clear();
+    buildingAt.Clear();
+    if (listener) listener->OnCleared();
+    pathGraph.Build(tiles);
+    RebuildTrackGraph();
 }
 
 void World::SetTileRaw(int x, int y, TileType type, float rotation) {
-    if (x >= 0 && x < cols && y >= 0 && y < rows) {
-        tiles[y][x].type = type;
-        tiles[y][x].rotation = rotation;
+    int w = GetTileWidth(type);
+    int h = GetTileHeight(type);
+    if (x < 0 || y < 0 || x + w > cols || y + h > rows) return;
+
+    uint8_t quarterTurns = DegreesToQuarterTurns(rotation);
+    for (int dy = 0; dy < h; dy++) {
+        for (int dx = 0; dx < w; dx++) {
+            Tile t = tiles.At(x + dx, y + dy);
+            t.type = type;
+            t.rotation = quarterTurns;
+            t.SetAnchorOffset(dx, dy);
+            tiles.Set(x + dx, y + dy, type == TileType::Empty ? Tile{} : t);
+        }
     }
+    if (listener) listener->OnTilesChanged(x, y, x + w - 1, y + h - 1);
+}
+
+void World::SetTilePlane(const Tile* plane, int planeRows, int planeCols, int originX, int originY) {
+    int x0 = std::max(originX, 0);
+    int y0 = std::max(originY, 0);
+    int x1 = std::min(originX + planeCols, cols) - 1;
+    int y1 = std::min(originY + planeRows, rows) - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    // Empty cells are skipped so they don't allocate storage
+    for (int y = y0; y <= y1; y++) {
+        const Tile* row = plane + (size_t)(y - originY) * planeCols - originX;
+        for (int x = x0; x <= x1; x++) {
+            if (row[x].type != TileType::Empty) tiles.Set(x, y, row[x]);
+        }
+    }
+    if (listener) listener->OnTilesChanged(x0, y0, x1, y1);
 }
 
 // Helper to get anchor position for a tile (returns itself if anchor or empty)
-Vector2 World::GetAnchorPos(int x, int y) const {
-    if (x < 0 || x >= cols || y < 0 || y >= rows) return {(float)x, (float)y};
-    const Tile& t = tiles[y][x];
-    if (t.isAnchor) return {(float)x, (float)y};
-    return {(float)(x + t.anchorOffsetX), (float)(y + t.anchorOffsetY)};
+GridPos World::GetAnchorPos(int x, int y) const {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return {x, y};
+    const Tile& t = tiles.At(x, y);
+    if (t.IsAnchor()) return {x, y};
+    return {x + t.AnchorOffsetX(), y + t.AnchorOffsetY()};
 }
 
 // Clear a multi-tile starting from any cell
 void World::ClearMultiTile(int x, int y) {
     if (x < 0 || x >= cols || y < 0 || y >= rows) return;
-    if (tiles[y][x].type == TileType::Empty) return;
+    if (tiles.At(x, y).type == TileType::Empty) return;
 
     // Find anchor
-    Vector2 anchor = GetAnchorPos(x, y);
-    int ax = (int)anchor.x;
-    int ay = (int)anchor.y;
+    GridPos anchor = GetAnchorPos(x, y);
+    int ax = anchor.x;
+    int ay = anchor.y;
 
     if (ax < 0 || ax >= cols || ay < 0 || ay >= rows) return;
 
-    TileType type = tiles[ay][ax].type;
+    TileType type = tiles.At(ax, ay).type;
     int w = GetTileWidth(type);
     int h = GetTileHeight(type);
 
+    MarkEdited(ax, ay, w, h);
+    if (type == TileType::Track || type == TileType::TrackCorner) editTouchedTrack = true;
+
     // Clear all cells of this multi-tile
     for (int dy = 0; dy < h; dy++) {
         for (int dx = 0; dx < w; dx++) {
             int cx = ax + dx;
             int cy = ay + dy;
             if (cx >= 0 && cx < cols && cy >= 0 && cy < rows) {
-                tiles[cy][cx] = Tile{};
+                if (history) history->RecordTileChange(cx, cy, tiles.At(cx, cy));
+                tiles.Set(cx, cy, Tile{});
             }
         }
     }
 }
 
-void World::SetTile(int x, int y, TileType type, float rotation) {
+void World::BeginEdit() {
+    editMinX = cols;
+    editMinY = rows;
+    editMaxX = -1;
+    editMaxY = -1;
+    lastEditCells = 0;
+    editTouchedTrack = false;
+}
+
+void World::MarkEdited(int x, int y, int w, int h) {
+    editMinX = std::min(editMinX, x);
+    editMinY = std::min(editMinY, y);
+    editMaxX = std::max(editMaxX, x + w - 1);
+    editMaxY = std::max(editMaxY, y + h - 1);
+    lastEditCells += w * h;
+}
+
+// Patches the path graph over the edited box, timed as its own profiler stage
+void World::UpdateEditedPathGraph() {
+    PROFILE_SCOPE(PathGraph);
+    pathGraph.UpdateRegion(tiles, editMinX, editMinY, editMaxX, editMaxY);
+}
+
+// Recompute connections for every anchor whose footprint or edge neighbours
+// fall inside the edited box, i.e. the box plus a one-cell ring.
+void World::UpdateEditedConnections() {
+    if (editMaxX < editMinX || editMaxY < editMinY) return;
+
+    int x0 = std::max(editMinX - 1, 0);
+    int y0 = std::max(editMinY - 1, 0);
+    int x1 = std::min(editMaxX + 1, cols - 1);
+    int y1 = std::min(editMaxY + 1, rows - 1);
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            if (tiles.At(x, y).type == TileType::Empty) continue;
+
+            // Visit each multi-tile once, from its first cell inside the scan box
+            GridPos anchor = GetAnchorPos(x, y);
+            int ax = anchor.x;
+            int ay = anchor.y;
+            if (x != std::max(ax, x0) || y != std::max(ay, y0)) continue;
+
+            UpdateTileConnections(ax, ay);
+            lastEditCells++;
+        }
+    }
+
+    // Re-evaluated anchors may reach MAX_TILE_SPAN - 1 cells past the ring
+    if (listener) {
+        listener->OnTilesChanged(editMinX - MAX_TILE_SPAN, editMinY - MAX_TILE_SPAN,
+                                 editMaxX + MAX_TILE_SPAN, editMaxY + MAX_TILE_SPAN);
+    }
+}
+
+bool World::SetTile(int x, int y, TileType type, float rotation) {
     int w = GetTileWidth(type);
     int h = GetTileHeight(type);
 
     // Check bounds for multi-tile
-    if (x < 0 || y < 0 || x + w > cols || y + h > rows) return;
+    if (x < 0 || y < 0 || x + w > cols || y + h > rows) return false;
+
+    BeginEdit();
 
     // For empty type, clear the tile at this position (handling multi-tiles)
     if (type == TileType::Empty) {
         ClearMultiTile(x, y);
-        UpdateAllConnections();
-        return;
+        if (lastEditCells == 0) return false;
+        UpdateEditedConnections();
+        UpdateEditedPathGraph();
+        if (editTouchedTrack) trackGraphDirty = true;
+        if (journal) journal->RecordSetTile(x, y, type, 0);
+        return true;
     }
 
+    // Re-placing an identical tile (e.g. while dragging) is a no-op
+    uint8_t quarterTurns = DegreesToQuarterTurns(rotation);
+    const Tile& existing = tiles.At(x, y);
+    if (existing.type == type && existing.IsAnchor() && existing.rotation == quarterTurns) return false;
+
     // Clear any existing tiles in the footprint
     for (int dy = 0; dy < h; dy++) {
         for (int dx = 0; dx < w; dx++) {
@@ -81,27 +185,30 @@ void World::SetTile(int x, int y, TileType type, float rotation) {
     // Place the new tile
     for (int dy = 0; dy < h; dy++) {
         for (int dx = 0; dx < w; dx++) {
-            Tile& t = tiles[y + dy][x + dx];
+            if (history) history->RecordTileChange(x + dx, y + dy, tiles.At(x + dx, y + dy));
+            Tile t;
             t.type = type;
-            t.connections = CONN_NONE;
-            t.rotation = rotation;
-            t.isAnchor = (dx == 0 && dy == 0);
-            t.anchorOffsetX = -dx;
-            t.anchorOffsetY = -dy;
+            t.rotation = quarterTurns;
+            t.SetAnchorOffset(dx, dy);
+            tiles.Set(x + dx, y + dy, t);
         }
     }
+    MarkEdited(x, y, w, h);
+    if (type == TileType::Track || type == TileType::TrackCorner) editTouchedTrack = true;
 
-    UpdateAllConnections();
+    UpdateEditedConnections();
+    UpdateEditedPathGraph();
+    if (editTouchedTrack) trackGraphDirty = true;
+    if (journal) journal->RecordSetTile(x, y, type, quarterTurns);
+    return true;
 }
 
 uint8_t World::CalculateConnections(int x, int y) const {
     if (x < 0 || x >= cols || y < 0 || y >= rows) return CONN_NONE;
 
-    const Tile& tile = tiles[y][x];
-    if (tile.type == TileType::Empty || tile.type == TileType::Path) return CONN_NONE;
-    // Track tiles use manual rotation, not auto-connection
-    if (tile.type == TileType::Track || tile.type == TileType::TrackCorner) return CONN_NONE;
-    if (!tile.isAnchor) return CONN_NONE;  // Only anchors track connections
+    const Tile& tile = tiles.At(x, y);
+    if (!UsesAutoConnections(tile.type)) return CONN_NONE;
+    if (!tile.IsAnchor()) return CONN_NONE;  // Only anchors track connections
 
     TileType myType = tile.type;
     int w = GetTileWidth(myType);
@@ -114,7 +221,7 @@ uint8_t World::CalculateConnections(int x, int y) const {
         int checkY = y - 1;
         int checkX = x + dx;
         if (checkY >= 0 && checkX < cols) {
-            TileType neighborType = tiles[checkY][checkX].type;
+            TileType neighborType = tiles.At(checkX, checkY).type;
             if (CanTilesConnect(myType, neighborType)) {
                 connections |= CONN_UP;
                 break;
@@ -127,7 +234,7 @@ uint8_t World::CalculateConnections(int x, int y) const {
         int checkY = y + h;
         int checkX = x + dx;
         if (checkY < rows && checkX < cols) {
-            TileType neighborType = tiles[checkY][checkX].type;
+            TileType neighborType = tiles.At(checkX, checkY).type;
             if (CanTilesConnect(myType, neighborType)) {
                 connections |= CONN_DOWN;
                 break;
@@ -140,7 +247,7 @@ uint8_t World::CalculateConnections(int x, int y) const {
         int checkY = y + dy;
         int checkX = x - 1;
         if (checkX >= 0 && checkY < rows) {
-            TileType neighborType = tiles[checkY][checkX].type;
+            TileType neighborType = tiles.At(checkX, checkY).type;
             if (CanTilesConnect(myType, neighborType)) {
                 connections |= CONN_LEFT;
                 break;
@@ -153,7 +260,7 @@ uint8_t World::CalculateConnections(int x, int y) const {
         int checkY = y + dy;
         int checkX = x + w;
         if (checkX < cols && checkY < rows) {
-            TileType neighborType = tiles[checkY][checkX].type;
+            TileType neighborType = tiles.At(checkX, checkY).type;
             if (CanTilesConnect(myType, neighborType)) {
                 connections |= CONN_RIGHT;
                 break;
@@ -166,100 +273,24 @@ uint8_t World::CalculateConnections(int x, int y) const {
 
 void World::UpdateTileConnections(int x, int y) {
     if (x < 0 || x >= cols || y < 0 || y >= rows) return;
-    if (!tiles[y][x].isAnchor) return;
-    tiles[y][x].connections = CalculateConnections(x, y);
+    Tile t = tiles.At(x, y);
+    if (!t.IsAnchor()) return;
+    uint8_t connections = CalculateConnections(x, y);
+    if (connections == t.connections) return;
+    t.connections = connections;
+    tiles.Set(x, y, t);
 }
 
 void World::UpdateAllConnections() {
-    for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            if (tiles[y][x].isAnchor && tiles[y][x].type != TileType::Empty) {
-                tiles[y][x].connections = CalculateConnections(x, y);
-            }
-        }
-    }
-}
-
-Tile World::GetTile(int x, int y) const {
-    if (x >= 0 && x < cols && y >= 0 && y < rows) {
-        return tiles[y][x];
-    }
-    return Tile{};
-}
-
-void World::Render(GameCamera& camera, TileTextures& textures) {
-    for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            const Tile& tile = tiles[y][x];
-
-            // Only render anchor tiles (skip non-anchor parts of multi-tiles)
-            if (tile.type == TileType::Empty || !tile.isAnchor) continue;
-
-            Vector2 pos = WorldToScreen(x, y, camera.offset, camera.zoom);
-            int w = GetTileWidth(tile.type);
-            int h = GetTileHeight(tile.type);
-            float renderW = TILE_SIZE * w * camera.zoom;
-            float renderH = TILE_SIZE * h * camera.zoom;
-
-            // Get shape and rotation
-            TileShape shape;
-            float rotation;
-            if (tile.type == TileType::Track) {
-                shape = TileShape::Straight;
-                rotation = tile.rotation;
-            } else if (tile.type == TileType::TrackCorner) {
-                shape = TileShape::Corner;
-                rotation = tile.rotation;
-            } else if (tile.type == TileType::Path) {
-                shape = TileShape::Single;
-                rotation = 0.0f;
-            } else {
-                shape = GetTileShape(tile.connections);
-                rotation = GetTileRotation(tile.connections);
-            }
-
-            if (textures.HasTexture(tile.type, shape)) {
-                Texture2D tex = textures.Get(tile.type, shape);
-                Rectangle source = { 0, 0, (float)tex.width, (float)tex.height };
-                // For rotation, we need to position dest at center and use origin
-                float centerX = pos.x + renderW / 2;
-                float centerY = pos.y + renderH / 2;
-                Rectangle dest = { centerX, centerY, renderW, renderH };
-                Vector2 origin = { renderW / 2, renderH / 2 };
-                DrawTexturePro(tex, source, dest, origin, rotation, WHITE);
-            } else {
-                Color color = GetTileColor(tile.type);
-                DrawRectangle((int)pos.x, (int)pos.y, (int)renderW, (int)renderH, color);
-            }
-        }
-    }
-}
-
-void World::RenderBuildings(GameCamera& camera, BuildingTextures& textures) {
-    // Sort indices by Y position so buildings further back render first
-    std::vector<int> order(buildings.size());
-    for (int i = 0; i < (int)buildings.size(); i++) order[i] = i;
-    std::sort(order.begin(), order.end(), [&](int a, int b) {
-        return buildings[a].gridY < buildings[b].gridY;
+    // Same result as CalculateConnections on every anchor, a chunk row at a time
+    ConnectionPlanes planes;
+    planes.Build(tiles);
+    planes.ForEachChange([&](int x, int y, uint8_t connections) {
+        Tile t = tiles.At(x, y);
+        t.connections = connections;
+        tiles.Set(x, y, t);
     });
-
-    for (int idx : order) {
-        const Building& b = buildings[idx];
-        if (b.type == BuildingType::None) continue;
-
-        Vector2 pos = WorldToScreen(b.gridX, b.gridY, camera.offset, camera.zoom);
-
-        // Apply render offset (scaled by zoom)
-        pos.x += b.renderOffsetX * camera.zoom;
-        pos.y += b.renderOffsetY * camera.zoom;
-
-        if (textures.HasTexture(b.type)) {
-            Texture2D tex = textures.Get(b.type);
-            Rectangle source = { 0, 0, (float)tex.width, (float)tex.height };
-            Rectangle dest = { pos.x, pos.y, tex.width * camera.zoom, tex.height * camera.zoom };
-            DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, WHITE);
-        }
-    }
+    if (listener) listener->OnAllTilesChanged();
 }
 
 bool World::CanPlace(const Placeable& placeable) const {
@@ -271,59 +302,91 @@ bool World::CanPlace(const Placeable& placeable) const {
     }
 
     // Check overlap with existing buildings
-    for (const Building& existing : buildings) {
-        if (existing.type == BuildingType::None) continue;
-
-        bool overlapX = placeable.gridX < existing.gridX + existing.width &&
-                        placeable.gridX + placeable.width > existing.gridX;
-        bool overlapY = placeable.gridY < existing.gridY + existing.height &&
-                        placeable.gridY + placeable.height > existing.gridY;
-
-        if (overlapX && overlapY) {
-            return false;
+    for (int y = placeable.gridY; y < placeable.gridY + placeable.height; y++) {
+        for (int x = placeable.gridX; x < placeable.gridX + placeable.width; x++) {
+            if (buildingAt.At(x, y) >= 0) return false;
         }
     }
 
     return true;
 }
 
+void World::FillBuildingCells(const Building& b, int32_t value) {
+    for (int y = b.gridY; y < b.gridY + b.height; y++) {
+        for (int x = b.gridX; x < b.gridX + b.width; x++) {
+            buildingAt.Set(x, y, value);
+        }
+    }
+}
+
 bool World::PlaceBuilding(BuildingType type, int gridX, int gridY) {
+    if (type == BuildingType::None) return false;
+
     Building b = CreateBuilding(type, gridX, gridY);
 
     if (!CanPlace(b)) {
         return false;
     }
 
+    FillBuildingCells(b, (int32_t)buildings.size());
     buildings.push_back(b);
+    if (listener) listener->OnBuildingAdded((int)buildings.size() - 1);
+    if (journal) journal->RecordPlaceBuilding(type, gridX, gridY);
+    if (history) history->RecordBuilding(true, type, gridX, gridY);
     return true;
 }
 
 bool World::RemoveBuilding(int gridX, int gridY) {
-    for (auto it = buildings.begin(); it != buildings.end(); ++it) {
-        // Check if the point is within the building's footprint
-        if (gridX >= it->gridX && gridX < it->gridX + it->width &&
-            gridY >= it->gridY && gridY < it->gridY + it->height) {
-            buildings.erase(it);
-            return true;
-        }
+    if (gridX < 0 || gridX >= cols || gridY < 0 || gridY >= rows) return false;
+
+    int idx = buildingAt.At(gridX, gridY);
+    if (idx < 0) return false;
+
+    if (history) history->RecordBuilding(false, buildings[idx].type, buildings[idx].gridX, buildings[idx].gridY);
+    FillBuildingCells(buildings[idx], -1);
+    if (listener) listener->OnBuildingRemoved(idx);
+
+    // Move the last building into the freed slot so indices stay dense
+    int last = (int)buildings.size() - 1;
+    if (idx != last) {
+        buildings[idx] = buildings[last];
+        FillBuildingCells(buildings[idx], idx);
+        if (listener) listener->OnBuildingMoved(last, idx);
     }
-    return false;
+    buildings.pop_back();
+    if (journal) journal->RecordRemoveBuilding(gridX, gridY);
+    return true;
 }
 
 Building* World::GetBuildingAt(int gridX, int gridY) {
-    for (Building& b : buildings) {
-        if (gridX >= b.gridX && gridX < b.gridX + b.width &&
-            gridY >= b.gridY && gridY < b.gridY + b.height) {
-            return &b;
-        }
-    }
-    return nullptr;
+    if (gridX < 0 || gridX >= cols || gridY < 0 || gridY >= rows) return nullptr;
+
+    int idx = buildingAt.At(gridX, gridY);
+    return idx >= 0 ? &buildings[idx] : nullptr;
 }
 
 void World::RebuildPathGraph() {
-    pathGraph.Build(tiles, rows, cols);
+    PROFILE_SCOPE(PathGraph);
+    pathGraph.Build(tiles, workers);
 }
 
-void World::RenderPathDebug(GameCamera& camera) {
-    pathGraph.RenderDebug(camera);
+size_t World::GetGridMemoryBytes() const {
+    return tiles.GetMemoryBytes() + buildingAt.GetMemoryBytes() + pathGraph.GetIndexMemoryBytes();
+}
+
+bool World::RestorePathGraph(std::vector<PathNode> nodes, std::vector<int> targets, std::vector<int> costs) {
+    return pathGraph.Restore(tiles, std::move(nodes), std::move(targets), std::move(costs));
+}
+
+void World::RebuildTrackGraph() {
+    trackGraph.Build(tiles);
+    trackGraphDirty = false;
+}
+
+const TrackGraph& World::GetTrackGraph() const {
+    if (trackGraphDirty) {
+        trackGraph.Build(tiles);
+        trackGraphDirty = false;
+    }
+    return trackGraph;
 }
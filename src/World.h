@@ -1,25 +1,73 @@
 #pragma once
 
 #include "Tile.h"
+#include "TileGrid.h"
 #include "Building.h"
 #include "Placeable.h"
 #include "PathGraph.h"
-#include "Camera.h"
+#include "TrackGraph.h"
 #include <vector>
 #include <string>
 
+class EditJournal;
+class EditHistory;
+
+// Receives World changes that views outside the core (the renderer's tile
+// cache and draw list) mirror. Cell ranges are inclusive and may reach past
+// the grid.
+class WorldListener {
+public:
+    virtual ~WorldListener() = default;
+    virtual void OnTilesChanged(int x0, int y0, int x1, int y1) = 0;
+    virtual void OnAllTilesChanged() = 0;
+    virtual void OnBuildingAdded(int index) = 0;
+    virtual void OnBuildingRemoved(int index) = 0;
+    // The building at index 'from' now lives at index 'to'
+    virtual void OnBuildingMoved(int from, int to) = 0;
+    virtual void OnCleared() = 0;
+};
+
 class World {
 private:
     int rows;
     int cols;
-    std::vector<std::vector<Tile>> tiles;
+    TileGrid tiles;
     std::vector<Building> buildings;
+    // Per-cell index into buildings, -1 where the cell is free
+    ChunkedGrid<int32_t> buildingAt;
     PathGraph pathGraph;
+    // Rebuilt on first use after a track edit, so bulk edits pay for one build
+    mutable TrackGraph trackGraph;
+    mutable bool trackGraphDirty = false;
+    // Receives every successful SetTile/PlaceBuilding/RemoveBuilding, if set
+    EditJournal* journal = nullptr;
+    // Receives the before state of every overwritten cell and building change, if set
+    EditHistory* history = nullptr;
+    // Told about every change to tiles and buildings, if set
+    WorldListener* listener = nullptr;
+    // Splits full path graph rebuilds across threads, if set
+    WorkerPool* workers = nullptr;
+
+    // Bounding box of cells changed by the current edit (inclusive)
+    int editMinX = 0, editMinY = 0, editMaxX = -1, editMaxY = -1;
+    int lastEditCells = 0;
+    bool editTouchedTrack = false;
+
+    // Fixed simulation ticks run since startup (see SimClock)
+    uint64_t simTick = 0;
 
     // Multi-tile helpers
-    Vector2 GetAnchorPos(int x, int y) const;
+    GridPos GetAnchorPos(int x, int y) const;
     void ClearMultiTile(int x, int y);
 
+    void FillBuildingCells(const Building& b, int32_t value);
+
+    // Edit tracking: only anchors next to changed cells need new connections
+    void BeginEdit();
+    void MarkEdited(int x, int y, int w, int h);
+    void UpdateEditedConnections();
+    void UpdateEditedPathGraph();
+
     // Update connections for a tile and its neighbors
     void UpdateTileConnections(int x, int y);
     uint8_t CalculateConnections(int x, int y) const;
@@ -27,10 +75,10 @@ private:
 public:
     World(int rows, int cols);
 
-    void SetTile(int x, int y, TileType type, float rotation = 0.0f);
-    Tile GetTile(int x, int y) const;
-    void Render(GameCamera& camera, TileTextures& textures);
-    void RenderBuildings(GameCamera& camera, BuildingTextures& textures);
+    // Returns true if the grid changed; connections and the path graph are patched locally
+    bool SetTile(int x, int y, TileType type, float rotation = 0.0f);
+    const Tile& GetTile(int x, int y) const { return tiles.Get(x, y); }
+    const TileGrid& GetTiles() const { return tiles; }
 
     // Placeable management
     bool CanPlace(const Placeable& placeable) const;
@@ -41,13 +89,39 @@ public:
 
     void Clear();
 
-    // Raw tile setter for loading (no connection update, no multi-tile handling)
+    // One fixed simulation step. Nothing moves on its own yet; trains and
+    // minifigures advance here and draw between ticks with SimClock's alpha.
+    void Tick() { simTick++; }
+    uint64_t GetSimTick() const { return simTick; }
+
+    // Raw tile setter for loading: stamps the footprint, no connection or graph update
     void SetTileRaw(int x, int y, TileType type, float rotation);
+    // Bulk copy of a row-major tile plane for loading, placed with its top-left
+    // cell at (originX, originY); only the part inside the world is copied
+    void SetTilePlane(const Tile* plane, int planeRows, int planeCols, int originX = 0, int originY = 0);
     void UpdateAllConnections();
 
+    // Full rebuild, needed after raw loads
     void RebuildPathGraph();
-    void RenderPathDebug(GameCamera& camera);
+    bool RestorePathGraph(std::vector<PathNode> nodes, std::vector<int> targets, std::vector<int> costs);
+    const PathGraph& GetPathGraph() const { return pathGraph; }
+    bool FindPath(GridPos from, GridPos to, std::vector<GridPos>& path) { return pathGraph.FindPath(tiles, from, to, path); }
+
+    void RebuildTrackGraph();
+    const TrackGraph& GetTrackGraph() const;
+
+    void SetJournal(EditJournal* editJournal) { journal = editJournal; }
+    void SetHistory(EditHistory* editHistory) { history = editHistory; }
+    EditJournal* GetJournal() const { return journal; }
+    EditHistory* GetHistory() const { return history; }
+    void SetListener(WorldListener* worldListener) { listener = worldListener; }
+    void SetWorkerPool(WorkerPool* pool) { workers = pool; }
+
+    // Number of cells written or re-evaluated by the last SetTile
+    int GetLastEditCells() const { return lastEditCells; }
 
     int GetRows() const { return rows; }
     int GetCols() const { return cols; }
+    // Bytes held by the sparse per-cell grids (tiles, building and path node lookups)
+    size_t GetGridMemoryBytes() const;
 };
@@ -0,0 +1,141 @@
+#include "WorldRenderer.h"
+
+// Buildings sort by the bottom edge of their footprint and cull by the footprint
+static int BuildingDepth(const Building& b) {
+    return (b.gridY + b.height) * TILE_SIZE;
+}
+
+static Rectangle BuildingBounds(const Building& b) {
+    return { (float)(b.gridX * TILE_SIZE), (float)(b.gridY * TILE_SIZE),
+             (float)(b.width * TILE_SIZE), (float)(b.height * TILE_SIZE) };
+}
+
+WorldRenderer::WorldRenderer(World& world) : world(world) {
+    tileCache.Resize(world.GetRows(), world.GetCols());
+    for (int i = 0; i < (int)world.GetBuildings().size(); i++) AddBuilding(i);
+    world.SetListener(this);
+}
+
+WorldRenderer::~WorldRenderer() {
+    world.SetListener(nullptr);
+}
+
+void WorldRenderer::AddBuilding(int index) {
+    const Building& b = world.GetBuildings()[index];
+    drawList.Insert(DrawKind::Building, index, BuildingDepth(b), BuildingBounds(b));
+}
+
+void WorldRenderer::OnCleared() {
+    drawList.Clear();
+    tileCache.MarkAllDirty();
+}
+
+void WorldRenderer::PrepareRender(GameCamera& camera, TileTextures& textures) {
+    tileCache.Update(world.GetTiles(), camera, textures);
+    renderStats.tilesVisited = tileCache.GetTilesVisited();
+    renderStats.tilesDrawn = tileCache.GetTilesDrawn();
+    renderStats.chunksRedrawn = tileCache.GetChunksRedrawn();
+}
+
+void WorldRenderer::Render(GameCamera& camera) {
+    tileCache.Draw(camera);
+    renderStats.chunksDrawn = tileCache.GetChunksDrawn();
+}
+
+void WorldRenderer::RenderObjects(GameCamera& camera, BuildingTextures& textures, [[maybe_unused]] float alpha) {
+    renderStats.buildingsVisited = 0;
+    renderStats.buildingsDrawn = 0;
+
+    // Widened so sprites that overhang their footprint from just off-screen are still drawn
+    int margin = (textures.GetMaxOverhang() + TILE_SIZE - 1) / TILE_SIZE;
+    int x0, y0, x1, y1;
+    if (!camera.VisibleCells(world.GetRows(), world.GetCols(), margin, x0, y0, x1, y1)) return;
+    Rectangle view = { (float)(x0 * TILE_SIZE), (float)(y0 * TILE_SIZE),
+                       (float)((x1 - x0 + 1) * TILE_SIZE), (float)((y1 - y0 + 1) * TILE_SIZE) };
+
+    const std::vector<Building>& buildings = world.GetBuildings();
+    size_t visited = drawList.Visit(view, [&](const DrawItem& item) {
+        switch (item.kind) {
+            case DrawKind::Building: {
+                // Buildings stand still, so alpha doesn't apply
+                const Building& b = buildings[item.id];
+                const AtlasSprite& sprite = textures.Get(b.type);
+                if (!sprite.IsValid()) break;
+
+                Vector2 pos = WorldToScreen(b.gridX, b.gridY, camera.offset, camera.zoom);
+                // Apply render offset (scaled by zoom)
+                pos.x += b.renderOffsetX * camera.zoom;
+                pos.y += b.renderOffsetY * camera.zoom;
+
+                Rectangle dest = { pos.x, pos.y, sprite.source.width * camera.zoom, sprite.source.height * camera.zoom };
+                DrawTexturePro(sprite.texture, sprite.source, dest, {0, 0}, 0.0f, WHITE);
+                renderStats.buildingsDrawn++;
+                break;
+            }
+        }
+    });
+    renderStats.buildingsVisited = (int)visited;
+}
+
+void WorldRenderer::RenderPathDebug(GameCamera& camera) {
+    const PathGraph& graph = world.GetPathGraph();
+    const std::vector<PathNode>& nodes = graph.GetNodes();
+    const std::vector<int>& edgeTargets = graph.GetEdgeTargets();
+    float halfTile = TILE_SIZE * camera.zoom * 0.5f;
+
+    // Draw edges as yellow lines
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        Vector2 from = WorldToScreen(nodes[i].x, nodes[i].y, camera.offset, camera.zoom);
+        from.x += halfTile;
+        from.y += halfTile;
+
+        for (int e = nodes[i].firstEdge; e < nodes[i].firstEdge + nodes[i].edgeCount; e++) {
+            int target = edgeTargets[e];
+            // Only draw each edge once (from lower index to higher)
+            if (target <= i) continue;
+
+            Vector2 to = WorldToScreen(nodes[target].x, nodes[target].y, camera.offset, camera.zoom);
+            to.x += halfTile;
+            to.y += halfTile;
+
+            DrawLineEx(from, to, 2.0f, YELLOW);
+        }
+    }
+
+    // Draw nodes as green circles on top
+    for (const PathNode& node : nodes) {
+        Vector2 pos = WorldToScreen(node.x, node.y, camera.offset, camera.zoom);
+        float radius = 4.0f * camera.zoom;
+        DrawCircle((int)(pos.x + halfTile), (int)(pos.y + halfTile), radius, GREEN);
+    }
+}
+
+void WorldRenderer::RenderTrackDebug(GameCamera& camera) {
+    const std::vector<TrackNode>& nodes = world.GetTrackGraph().GetNodes();
+    float halfTile = TILE_SIZE * camera.zoom * 0.5f;
+
+    // Draw edges between the facing ports as orange lines
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        for (int p = 0; p < nodes[i].portCount; p++) {
+            const TrackEdge& edge = nodes[i].edges[p];
+            // Only draw each edge once (from lower index to higher)
+            if (edge.target < i) continue;
+
+            const TrackPort& fromPort = nodes[i].ports[p];
+            const TrackPort& toPort = nodes[edge.target].ports[edge.targetPort];
+            Vector2 from = WorldToScreen(fromPort.x, fromPort.y, camera.offset, camera.zoom);
+            Vector2 to = WorldToScreen(toPort.x, toPort.y, camera.offset, camera.zoom);
+            DrawLineEx({from.x + halfTile, from.y + halfTile}, {to.x + halfTile, to.y + halfTile}, 2.0f, ORANGE);
+        }
+    }
+
+    // Draw each node's ports as circles, red when the port is open
+    for (const TrackNode& node : nodes) {
+        for (int p = 0; p < node.portCount; p++) {
+            Vector2 pos = WorldToScreen(node.ports[p].x, node.ports[p].y, camera.offset, camera.zoom);
+            float radius = 3.0f * camera.zoom;
+            Color color = node.edges[p].target < 0 ? RED : SKYBLUE;
+            DrawCircle((int)(pos.x + halfTile), (int)(pos.y + halfTile), radius, color);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "raylib.h"
+#include "World.h"
+#include "Camera.h"
+#include "TileTextures.h"
+#include "BuildingTextures.h"
+#include "TileLayerCache.h"
+#include "DrawList.h"
+
+// Per-frame rendering counters. Tile counts cover chunk redraws only; a
+// clean frame draws cached chunks without touching tiles.
+struct RenderStats {
+    int tilesVisited = 0;
+    int tilesDrawn = 0;
+    int chunksDrawn = 0;
+    int chunksRedrawn = 0;
+    int buildingsVisited = 0;
+    int buildingsDrawn = 0;
+};
+
+// Draws a World. Listens to its edits to keep the cached tile chunks and the
+// depth-ordered draw list current, so World itself stays free of raylib.
+class WorldRenderer : public WorldListener {
+private:
+    World& world;
+    RenderStats renderStats;
+    TileLayerCache tileCache;
+    // Buildings (and later anything else above the ground) in depth order
+    DrawList drawList;
+
+    void AddBuilding(int index);
+
+public:
+    // Attaches to the world and picks up the buildings it already has
+    explicit WorldRenderer(World& world);
+    ~WorldRenderer() override;
+    WorldRenderer(const WorldRenderer&) = delete;
+    WorldRenderer& operator=(const WorldRenderer&) = delete;
+
+    // Redraws tile chunks changed since they were last shown; call before BeginDrawing
+    void PrepareRender(GameCamera& camera, TileTextures& textures);
+    // Ground layer: the cached tile chunks on screen
+    void Render(GameCamera& camera);
+    // Everything standing on the ground, back to front in one pass. alpha is
+    // SimClock::GetAlpha(): kinds that move per tick draw that far from their
+    // previous tick's position to the current one.
+    void RenderObjects(GameCamera& camera, BuildingTextures& textures, float alpha);
+    void RenderPathDebug(GameCamera& camera);
+    void RenderTrackDebug(GameCamera& camera);
+    // Frees GPU resources held by the tile cache; call before CloseWindow
+    void Unload() { tileCache.Unload(); }
+    const RenderStats& GetStats() const { return renderStats; }
+
+    void OnTilesChanged(int x0, int y0, int x1, int y1) override { tileCache.MarkDirty(x0, y0, x1, y1); }
+    void OnAllTilesChanged() override { tileCache.MarkAllDirty(); }
+    void OnBuildingAdded(int index) override { AddBuilding(index); }
+    void OnBuildingRemoved(int index) override { drawList.Remove(DrawKind::Building, index); }
+    void OnBuildingMoved(int from, int to) override { drawList.Renumber(DrawKind::Building, from, to); }
+    void OnCleared() override;
+};
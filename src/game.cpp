@@ -1,13 +1,30 @@
 #include "raylib.h"
 #include "Tile.h"
 #include "Building.h"
+#include "TileTextures.h"
+#include "BuildingTextures.h"
 #include "Camera.h"
 #include "World.h"
+#include "WorldRenderer.h"
 #include "SaveFileHandler.h"
+#include "EditHistory.h"
+#include "AssetPack.h"
+#include "SimClock.h"
+#include "FrameProfiler.h"
+#include "ProfilerOverlay.h"
 #include <cmath>
 #include <string>
+#include <chrono>
 
-const char* SAVE_PATH = "saves/world.json";
+const char* SAVE_PATH = "saves/world.loco";
+// Snapshot plus journal of the running session, kept apart from manual saves
+const char* AUTOSAVE_PATH = "saves/autosave.loco";
+const char* EXPORT_PATH = "saves/world.json";
+const char* TRACE_PATH = "frame_trace.json";
+
+// Map size in tiles; storage is sparse, so only built-up chunks cost memory
+const int WORLD_ROWS = 4096;
+const int WORLD_COLS = 4096;
 
 Vector2 WorldToScreen(int gridX, int gridY, Vector2 cameraOffset, float zoom) {
     float screenX = gridX * TILE_SIZE * zoom + cameraOffset.x;
@@ -22,49 +39,39 @@ Vector2 ScreenToWorld(Vector2 screenPos, Vector2 cameraOffset, float zoom) {
 }
 
 int main() {
-    // Load background to get its dimensions
-    Image bgImage = LoadImage("resources/background00.png");
-    const int screenWidth = bgImage.width;
-    const int screenHeight = bgImage.height;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // All sprites in one baked file; fall back to decoding the sources if it hasn't been built
+    AssetPack assets;
+    if (!assets.Load(AssetPack::DEFAULT_PATH)) {
+        TraceLog(LOG_WARNING, "%s, packing assets from source images", assets.GetLastError().c_str());
+        if (!assets.LoadSources()) TraceLog(LOG_WARNING, "%s", assets.GetLastError().c_str());
+    }
+
+    // The background sets the window size
+    AtlasSprite background = assets.Get("background00");
+    const int screenWidth = (int)background.source.width;
+    const int screenHeight = (int)background.source.height;
 
     InitWindow(screenWidth, screenHeight, "openLegoLoco");
     SetTargetFPS(60);
 
-    // Convert image to texture and unload image
-    Texture2D background = LoadTextureFromImage(bgImage);
-    UnloadImage(bgImage);
+    assets.Upload();
+    background = assets.Get("background00");
 
     TileTextures tileTextures;
-    tileTextures.Load();
+    tileTextures.Load(assets);
 
     BuildingTextures buildingTextures;
-    buildingTextures.Load();
+    buildingTextures.Load(assets);
 
-    // Load toybox animation frames from sprite sheet (27 frames, 167px cells)
+    // Toybox animation frames (27 frames, 167px cells) and the tray (fully opened toybox state)
     const int TOYBOX_FRAME_COUNT = 27;
-    const int TOYBOX_CELL_WIDTH = 167;
-    Texture2D toyboxFrames[TOYBOX_FRAME_COUNT];
-    {
-        Image sheet = LoadImage("resources/raw/toybox.bmp");
-        ImageFormat(&sheet, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-        ImageColorReplace(&sheet, {255, 0, 255, 255}, {0, 0, 0, 0});
-        for (int i = 0; i < TOYBOX_FRAME_COUNT; i++)
-        {
-            Image frame = ImageCopy(sheet);
-            ImageCrop(&frame, {(float)(i*TOYBOX_CELL_WIDTH), 0,
-                               (float)TOYBOX_CELL_WIDTH, (float)sheet.height});
-            toyboxFrames[i] = LoadTextureFromImage(frame);
-            UnloadImage(frame);
-        }
-        UnloadImage(sheet);
+    AtlasSprite toyboxFrames[TOYBOX_FRAME_COUNT];
+    for (int i = 0; i < TOYBOX_FRAME_COUNT; i++) {
+        toyboxFrames[i] = assets.Get("toybox." + std::to_string(i));
     }
-
-    // Load tray texture (fully opened toybox state)
-    Image trayImage = LoadImage("resources/raw/tray.bmp");
-    ImageFormat(&trayImage, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-    ImageColorReplace(&trayImage, {255, 0, 255, 255}, {0, 0, 0, 0});
-    Texture2D trayTexture = LoadTextureFromImage(trayImage);
-    UnloadImage(trayImage);
+    AtlasSprite traySprite = assets.Get("tray");
 
     // Toybox state
     enum ToyboxState { TOYBOX_CLOSED, TOYBOX_OPENING, TOYBOX_OPEN, TOYBOX_CLOSING };
@@ -86,12 +93,13 @@ int main() {
     bool toyboxMouseDown = false;
     const float TOYBOX_DRAG_THRESHOLD = 4.0f;
 
-    // Calculate world size based on background resolution
-    int worldCols = screenWidth / TILE_SIZE;
-    int worldRows = screenHeight / TILE_SIZE;
-    World world(worldRows, worldCols);
+    World world(WORLD_ROWS, WORLD_COLS);
+    WorldRenderer renderer(world);
     SaveFileHandler saveHandler;
+    EditHistory history;
+    world.SetHistory(&history);
     GameCamera camera;
+    camera.SetWorldSize(world.GetRows(), world.GetCols());
 
     TileType selectedTile = TileType::Path;
     const TileType tileTypes[] = { TileType::Empty, TileType::Path, TileType::Road, TileType::Track, TileType::TrackCorner };
@@ -105,42 +113,100 @@ int main() {
 
     // Debug
     bool showDebug = false;
+#if LOCO_PROFILE
+    bool showProfiler = false;
+#endif
+
+    // Simulation runs in fixed ticks, independent of the frame rate
+    SimClock simClock;
 
     // Status message
     std::string statusMessage = "";
     float statusTimer = 0.0f;
 
+    // Resume the last session: autosave plus any journaled edits made after it,
+    // or the last save when there is no autosave yet
+    if (!FileExists(AUTOSAVE_PATH) && FileExists(SAVE_PATH)) saveHandler.Load(world, SAVE_PATH);
+    if (!saveHandler.OpenWorld(world, AUTOSAVE_PATH)) {
+        statusMessage = "Failed to load: " + saveHandler.GetLastError();
+        statusTimer = 4.0f;
+    } else if (saveHandler.GetReplayedCount() > 0) {
+        statusMessage = TextFormat("Restored %d unsaved edits", saveHandler.GetReplayedCount());
+        statusTimer = 4.0f;
+    }
+
+    bool firstFrame = true;
     while (!WindowShouldClose()) {
+        PROFILE_FRAME_BEGIN();
         float dt = GetFrameTime();
+        PROFILE_BEGIN(Camera);
         camera.Update();
+        PROFILE_END();
+
+        PROFILE_BEGIN(Save);
+        // Save with Ctrl+S; serialization and disk writes run in the background
+        // (queued behind a journal checkpoint that is still being written)
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_S)) {
+            saveHandler.SaveAsync(world, SAVE_PATH);
+            statusMessage = "Saving...";
+            statusTimer = 0.0f;
+        }
+        bool saveSucceeded = false;
+        if (saveHandler.PollSave(saveSucceeded)) {
+            statusMessage = saveSucceeded ? "World saved!" : "Failed to save!";
+            statusTimer = 2.0f;
+        }
 
+        // Journal last frame's edits; checkpoints start here when the journal grows
+        saveHandler.Autosave(world, dt);
+        PROFILE_END();
+
+        PROFILE_BEGIN(Input);
         // Update status timer
         if (statusTimer > 0) {
             statusTimer -= dt;
             if (statusTimer <= 0) statusMessage = "";
         }
 
-        // Save with Ctrl+S
-        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_S)) {
-            if (saveHandler.Save(world, SAVE_PATH)) {
-                statusMessage = "World saved!";
+        // Revert to the last save with Ctrl+L; the autosave journal starts over from it
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_L)) {
+            if (saveHandler.Load(world, SAVE_PATH)) {
+                history.Clear();
+                statusMessage = "World loaded!";
             } else {
-                statusMessage = "Failed to save!";
+                statusMessage = "Failed to load: " + saveHandler.GetLastError();
             }
             statusTimer = 2.0f;
         }
 
-        // Load with Ctrl+L
-        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_L)) {
-            if (saveHandler.Load(world, SAVE_PATH)) {
-                statusMessage = "World loaded!";
-                world.RebuildPathGraph();
+        // JSON export/import with Ctrl+E / Ctrl+I
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_E)) {
+            if (saveHandler.Save(world, EXPORT_PATH)) {
+                statusMessage = "World exported to JSON!";
+            } else {
+                statusMessage = "Failed to export!";
+            }
+            statusTimer = 2.0f;
+        }
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_I)) {
+            if (saveHandler.Load(world, EXPORT_PATH)) {
+                history.Clear();
+                statusMessage = "World imported from JSON!";
             } else {
-                statusMessage = "Failed to load!";
+                statusMessage = "Failed to import: " + saveHandler.GetLastError();
             }
             statusTimer = 2.0f;
         }
 
+        // Undo with Ctrl+Z, redo with Ctrl+Y or Ctrl+Shift+Z
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_Z)) {
+            if (IsKeyDown(KEY_LEFT_SHIFT)) history.Redo(world);
+            else history.Undo(world);
+        }
+        if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_Y)) {
+            history.Redo(world);
+        }
+
         // Tile selection with number keys
         if (IsKeyPressed(KEY_ONE))   { selectedIndex = 0; selectedTile = tileTypes[0]; buildingMode = false; previewRotation = 0.0f; }
         if (IsKeyPressed(KEY_TWO))   { selectedIndex = 1; selectedTile = tileTypes[1]; buildingMode = false; previewRotation = 0.0f; }
@@ -156,6 +222,33 @@ int main() {
         // Debug toggle
         if (IsKeyPressed(KEY_F1)) showDebug = !showDebug;
 
+#if LOCO_PROFILE
+        // Frame profiler: F2 shows per-stage timings, F3 dumps the held frames as a Chrome trace
+        if (IsKeyPressed(KEY_F2)) showProfiler = !showProfiler;
+        if (IsKeyPressed(KEY_F3)) {
+            if (FrameProfiler::Get().WriteTrace(TRACE_PATH)) {
+                statusMessage = TextFormat("Trace of %d frames written to %s", FrameProfiler::Get().GetFrameCount(), TRACE_PATH);
+            } else {
+                statusMessage = "Failed to write trace!";
+            }
+            statusTimer = 2.0f;
+        }
+#endif
+
+        // Game speed: Space pauses, +/- step through 1x/2x/4x/16x
+        if (IsKeyPressed(KEY_SPACE)) simClock.TogglePause();
+        if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) simClock.SpeedUp();
+        if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) simClock.SlowDown();
+
+        PROFILE_END();
+
+        // Run the simulation ticks this frame's time adds up to
+        PROFILE_BEGIN(Simulation);
+        simClock.BeginFrame(dt);
+        while (simClock.Step()) world.Tick();
+        PROFILE_END();
+
+        PROFILE_BEGIN(Input);
         // Toybox animation update
         if (toyboxState == TOYBOX_OPENING || toyboxState == TOYBOX_CLOSING)
         {
@@ -187,13 +280,13 @@ int main() {
         // Compute current toybox draw rect from anchor
         // When open, use tray; otherwise use current animation frame
         Vector2 mousePos = GetMousePosition();
-        Texture2D currentToyboxTex = (toyboxState == TOYBOX_OPEN)
-            ? trayTexture : toyboxFrames[toyboxFrame];
+        const AtlasSprite& currentToybox = (toyboxState == TOYBOX_OPEN)
+            ? traySprite : toyboxFrames[toyboxFrame];
         float toyboxDrawX = toyboxAnchor.x - TOYBOX_ANCHOR_X;
         float toyboxDrawY = toyboxAnchor.y - TOYBOX_CELL_HEIGHT;
         Rectangle toyboxRect = {toyboxDrawX, toyboxDrawY,
-                                (float)currentToyboxTex.width,
-                                (float)currentToyboxTex.height};
+                                currentToybox.source.width,
+                                currentToybox.source.height};
         bool mouseOverToybox = CheckCollisionPointRec(mousePos, toyboxRect);
 
         // Toybox click vs drag detection
@@ -254,16 +347,19 @@ int main() {
         int hoverY = (int)floorf(worldPos.y);
         bool validHover = hoverX >= 0 && hoverX < world.GetCols() && hoverY >= 0 && hoverY < world.GetRows();
 
-        bool tilesChanged = false;
         bool isTrackType = (selectedTile == TileType::Track || selectedTile == TileType::TrackCorner);
 
+        // Everything placed or removed during one mouse stroke undoes as one step
+        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) || IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
+            history.BeginStep();
+        }
+
         // Place tile or building with left click (not when dragging toybox)
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && validHover && !toyboxDragging && !mouseOverToybox) {
             if (buildingMode) {
                 world.PlaceBuilding(selectedBuilding, hoverX, hoverY);
             } else {
                 world.SetTile(hoverX, hoverY, selectedTile, previewRotation);
-                tilesChanged = true;
             }
         }
 
@@ -271,7 +367,6 @@ int main() {
         bool is1x1Tile = (GetTileWidth(selectedTile) == 1 && GetTileHeight(selectedTile) == 1);
         if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && !IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && validHover && !buildingMode && is1x1Tile && !isTrackType && !toyboxDragging) {
             world.SetTile(hoverX, hoverY, selectedTile, previewRotation);
-            tilesChanged = true;
         }
 
         // Right click: rotate preview for tracks, remove for everything else
@@ -283,7 +378,6 @@ int main() {
                     world.RemoveBuilding(hoverX, hoverY);
                 } else {
                     world.SetTile(hoverX, hoverY, TileType::Empty);
-                    tilesChanged = true;
                 }
             }
         }
@@ -291,25 +385,46 @@ int main() {
         // Continuous removal (drag) - only for non-track tiles
         if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT) && !IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) && validHover && !buildingMode && !isTrackType) {
             world.SetTile(hoverX, hoverY, TileType::Empty);
-            tilesChanged = true;
         }
 
-        if (tilesChanged) world.RebuildPathGraph();
+        if (!IsMouseButtonDown(MOUSE_BUTTON_LEFT) && !IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+            history.EndStep(world);
+        }
+        PROFILE_END();
+
+        PROFILE_BEGIN(PrepareRender);
+        renderer.PrepareRender(camera, tileTextures);
+        PROFILE_END();
 
+        PROFILE_BEGIN(RenderTiles);
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
-        // Draw background (scales and pans with camera)
-        Rectangle bgSource = { 0, 0, (float)background.width, (float)background.height };
-        Rectangle bgDest = { camera.offset.x, camera.offset.y,
-                             background.width * camera.zoom, background.height * camera.zoom };
-        DrawTexturePro(background, bgSource, bgDest, {0, 0}, 0.0f, WHITE);
+        // Background repeats across the world, scaling and panning with the camera
+        float bgWidth = background.source.width * camera.zoom;
+        float bgHeight = background.source.height * camera.zoom;
+        float bgStartX = camera.offset.x + floorf(-camera.offset.x / bgWidth) * bgWidth;
+        float bgStartY = camera.offset.y + floorf(-camera.offset.y / bgHeight) * bgHeight;
+        for (float bgY = bgStartY; bgHeight > 0 && bgY < screenHeight; bgY += bgHeight) {
+            for (float bgX = bgStartX; bgWidth > 0 && bgX < screenWidth; bgX += bgWidth) {
+                DrawTexturePro(background.texture, background.source, { bgX, bgY, bgWidth, bgHeight }, {0, 0}, 0.0f, WHITE);
+            }
+        }
+
+        renderer.Render(camera);
+        PROFILE_END();
 
-        world.Render(camera, tileTextures);
-        world.RenderBuildings(camera, buildingTextures);
+        PROFILE_BEGIN(RenderObjects);
+        renderer.RenderObjects(camera, buildingTextures, simClock.GetAlpha());
+        PROFILE_END();
 
-        if (showDebug) world.RenderPathDebug(camera);
+        if (showDebug) {
+            PROFILE_SCOPE(Debug);
+            renderer.RenderPathDebug(camera);
+            renderer.RenderTrackDebug(camera);
+        }
 
+        PROFILE_BEGIN(UI);
         // Draw hover highlight
         if (validHover) {
             float tileSize = TILE_SIZE * camera.zoom;
@@ -327,14 +442,13 @@ int main() {
                 Color outlineColor = canPlace ? GREEN : RED;
 
                 // Show texture preview with tint
-                if (buildingTextures.HasTexture(selectedBuilding)) {
-                    Texture2D tex = buildingTextures.Get(selectedBuilding);
-                    Rectangle source = { 0, 0, (float)tex.width, (float)tex.height };
+                const AtlasSprite& sprite = buildingTextures.Get(selectedBuilding);
+                if (sprite.IsValid()) {
                     // Apply render offset to preview position
                     float previewX = pos.x + preview.renderOffsetX * camera.zoom;
                     float previewY = pos.y + preview.renderOffsetY * camera.zoom;
-                    Rectangle dest = { previewX, previewY, tex.width * camera.zoom, tex.height * camera.zoom };
-                    DrawTexturePro(tex, source, dest, {0, 0}, 0.0f, tint);
+                    Rectangle dest = { previewX, previewY, sprite.source.width * camera.zoom, sprite.source.height * camera.zoom };
+                    DrawTexturePro(sprite.texture, sprite.source, dest, {0, 0}, 0.0f, tint);
                 }
 
                 // Footprint outline
@@ -357,14 +471,13 @@ int main() {
                 else if (selectedTile == TileType::TrackCorner) previewShape = TileShape::Corner;
                 else previewShape = TileShape::Straight;
 
-                if (tileTextures.HasTexture(selectedTile, previewShape)) {
-                    Texture2D tex = tileTextures.Get(selectedTile, previewShape);
-                    Rectangle source = { 0, 0, (float)tex.width, (float)tex.height };
+                const AtlasSprite& sprite = tileTextures.Get(selectedTile, previewShape);
+                if (sprite.IsValid()) {
                     float centerX = pos.x + previewW / 2;
                     float centerY = pos.y + previewH / 2;
                     Rectangle dest = { centerX, centerY, previewW, previewH };
                     Vector2 origin = { previewW / 2, previewH / 2 };
-                    DrawTexturePro(tex, source, dest, origin, previewRotation, tint);
+                    DrawTexturePro(sprite.texture, sprite.source, dest, origin, previewRotation, tint);
                 } else {
                     DrawRectangle((int)pos.x, (int)pos.y, (int)previewW, (int)previewH, tint);
                 }
@@ -377,7 +490,7 @@ int main() {
         }
 
         // Draw toybox (anchored at bottom-center)
-        DrawTexture(currentToyboxTex, (int)toyboxDrawX, (int)toyboxDrawY, WHITE);
+        DrawTextureRec(currentToybox.texture, currentToybox.source, {(float)(int)toyboxDrawX, (float)(int)toyboxDrawY}, WHITE);
 
         // UI - Tile/Building palette
         DrawRectangle(10, 10, 180, 240, Color{0, 0, 0, 150});
@@ -401,10 +514,29 @@ int main() {
         // Debug info
         DrawRectangle(5, screenHeight - 55, screenWidth - 10, 50, Color{0, 0, 0, 150});
         DrawText(TextFormat("Grid: %d, %d", hoverX, hoverY), 10, screenHeight - 50, 16, WHITE);
+        if (showDebug) {
+            const RenderStats& stats = renderer.GetStats();
+            DrawText(TextFormat("Last edit: %d cells | Chunks drawn %d, redrawn %d (tiles %d/%d) | Buildings drawn %d/%d visited",
+                                world.GetLastEditCells(), stats.chunksDrawn, stats.chunksRedrawn,
+                                stats.tilesDrawn, stats.tilesVisited, stats.buildingsDrawn, stats.buildingsVisited),
+                     150, screenHeight - 50, 16, WHITE);
+        }
+
+        // Game speed, plus tick counters in debug mode
+        const char* speedText = simClock.IsPaused() ? "Paused" : TextFormat("Speed %dx", simClock.GetSpeed());
+        if (showDebug) {
+            speedText = TextFormat("%s | Tick %llu | %d ticks/s, %d this frame", speedText,
+                                   (unsigned long long)simClock.GetTick(), simClock.GetTicksPerSecond(),
+                                   simClock.GetFrameTicks());
+        }
+        int speedWidth = MeasureText(speedText, 16);
+        DrawRectangle(screenWidth - speedWidth - 25, screenHeight - 85, speedWidth + 20, 26, Color{0, 0, 0, 150});
+        DrawText(speedText, screenWidth - speedWidth - 15, screenHeight - 80, 16,
+                 simClock.IsPaused() ? YELLOW : WHITE);
         if (!buildingMode && isTrackType) {
-            DrawText(TextFormat("LMB: Place | RMB: Rotate (%d) | MMB: Pan | Scroll: Zoom | Ctrl+S/L: Save/Load | F1: Debug", (int)previewRotation), 10, screenHeight - 25, 14, LIGHTGRAY);
+            DrawText(TextFormat("LMB: Place | RMB: Rotate (%d) | MMB/Arrows: Pan | Scroll: Zoom | Ctrl+S/L: Save/Revert | Ctrl+E/I: JSON | Ctrl+Z/Y: Undo/Redo | Space/+/-: Speed | F1: Debug | F2/F3: Profile", (int)previewRotation), 10, screenHeight - 25, 14, LIGHTGRAY);
         } else {
-            DrawText("LMB: Place | RMB: Remove | MMB: Pan | Scroll: Zoom | Ctrl+S/L: Save/Load | F1: Debug", 10, screenHeight - 25, 14, LIGHTGRAY);
+            DrawText("LMB: Place | RMB: Remove | MMB/Arrows: Pan | Scroll: Zoom | Ctrl+S/L: Save/Revert | Ctrl+E/I: JSON | Ctrl+Z/Y: Undo/Redo | Space/+/-: Speed | F1: Debug | F2/F3: Profile", 10, screenHeight - 25, 14, LIGHTGRAY);
         }
 
         // Status message
@@ -414,14 +546,27 @@ int main() {
             DrawText(statusMessage.c_str(), screenWidth/2 - textWidth/2, 15, 20, GREEN);
         }
 
+#if LOCO_PROFILE
+        if (showProfiler) DrawProfilerOverlay(FrameProfiler::Get(), 200, 10);
+#endif
+        PROFILE_END();
+
+        PROFILE_BEGIN(Present);
         EndDrawing();
+        PROFILE_END();
+        PROFILE_FRAME_END();
+
+        if (firstFrame) {
+            firstFrame = false;
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            TraceLog(LOG_INFO, "First frame after %.1f ms", ms);
+        }
     }
 
-    for (int i = 0; i < TOYBOX_FRAME_COUNT; i++) UnloadTexture(toyboxFrames[i]);
-    UnloadTexture(trayTexture);
-    UnloadTexture(background);
     tileTextures.Unload();
     buildingTextures.Unload();
+    assets.Unload();
+    renderer.Unload();
     CloseWindow();
     return 0;
 }
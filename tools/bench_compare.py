@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Compare two lego_loco_bench result files: print each timing side by side
+and exit non-zero if any got slower than the threshold allows.
+
+    lego_loco_bench --label before --out before.json
+    (change something, rebuild)
+    lego_loco_bench --label after --out after.json
+    tools/bench_compare.py before.json after.json
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    for r in data["results"]:
+        results[(r["profile"], r["size"], r["op"])] = r
+    return data.get("label") or path, results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("before")
+    parser.add_argument("after")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="Relative slowdown reported as a regression (default 0.10)")
+    parser.add_argument("--stat", choices=("median", "min"), default="median",
+                        help="Which timing to compare; min is steadier on noisy machines")
+    args = parser.parse_args()
+
+    before_label, before = load(args.before)
+    after_label, after = load(args.after)
+
+    print(f"{'profile':8} {'size':>5} {'op':22} {before_label[:12]:>12} {after_label[:12]:>12} {'change':>8}")
+    regressions = 0
+    for key in sorted(before.keys() & after.keys(), key=lambda k: (k[0], k[1], k[2])):
+        old = before[key][args.stat]
+        new = after[key][args.stat]
+        unit = after[key]["unit"]
+        change = (new - old) / old if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  slower"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  faster"
+        profile, size, op = key
+        print(f"{profile:8} {size:5} {op:22} {old:9.3f} {unit:2} {new:9.3f} {unit:2} {change:+7.1%}{flag}")
+
+    for key in sorted(before.keys() ^ after.keys()):
+        print(f"only in {'before' if key in before else 'after'}: {key[0]} {key[1]} {key[2]}")
+
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,448 @@
+// Times the core world operations on synthetic maps from 64x64 up to
+// 4096x4096 and writes the results as JSON, so runs from two commits can be
+// compared with tools/bench_compare.py:
+//   lego_loco_bench [--sizes 64,256,1024,4096] [--profiles mixed,town]
+//                   [--threads 1,2,4,8] [--reps N] [--label TEXT] [--out FILE]
+// Progress goes to stderr; the JSON goes to --out, or stdout without it.
+//
+// Timed: SetTile, UpdateAllConnections, PathGraph::Build (serial, and on a
+// worker pool of each --threads size as "PathGraph::Build/4t"),
+// PathGraph::Traverse (a breadth-first walk over every node and edge of the
+// built graph, in ns per edge), CanPlace, FindPath, and binary and JSON Save
+// and Load (JSON up to 1024x1024). Every timing is the median of --reps runs
+// (default 3).
+//
+// FindPath is timed per query; each run's p50 and p99 are reported as the
+// median over reps ("FindPath/p50", "FindPath/p99").
+//
+// Exits with 1 if a pooled path graph build differs from the serial one, or
+// if a save or load fails.
+#include "World.h"
+#include "SaveFileHandler.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+// How a synthetic map is laid out. The map is cut into blockPitch-cell blocks
+// by vertical roads; each block row is bounded by a road or, with
+// railRowShare, a rail line. townShare of the blocks are filled with rows of
+// houses along paths, the rest get pathNoise scattered paths and an
+// occasional track corner.
+struct Profile {
+    const char* name;
+    int blockPitch;
+    double railRowShare;
+    double townShare;
+    double pathNoise;
+};
+
+static const Profile PROFILES[] = {
+    { "mixed", 24, 0.35, 0.3, 0.03 },  // countryside: rail lines, scattered towns
+    { "town", 12, 0.1, 0.9, 0.0 },     // dense streets packed with houses
+};
+
+static const int SET_TILE_EDITS = 5000;
+static const int CAN_PLACE_QUERIES = 1000000;
+// More than the path cache holds, so nearly every query searches
+static const int FIND_PATH_QUERIES = 2000;
+// JSON saves of bigger maps take minutes and hundreds of megabytes
+static const int MAX_JSON_SIZE = 1024;
+
+// Keeps the compiler from dropping loops whose results are otherwise unused
+static volatile long benchSink;
+
+struct Result {
+    std::string profile;
+    int size;
+    std::string op;
+    const char* unit;
+    double median;
+    double min;
+    long count;  // calls per run for per-call units, else 1
+};
+
+struct WorldInfo {
+    std::string profile;
+    int size;
+    long tiles;
+    long buildings;
+    long pathNodes;
+    long pathEdges;
+};
+
+// Stamps a tile only where its whole footprint is free, so generated
+// multi-tiles never overlap
+static void Stamp(World& world, int x, int y, TileType type, float rotation = 0.0f) {
+    int w = GetTileWidth(type);
+    int h = GetTileHeight(type);
+    if (x < 0 || y < 0 || x + w > world.GetCols() || y + h > world.GetRows()) return;
+    for (int dy = 0; dy < h; dy++) {
+        for (int dx = 0; dx < w; dx++) {
+            if (world.GetTile(x + dx, y + dy).type != TileType::Empty) return;
+        }
+    }
+    world.SetTileRaw(x, y, type, rotation);
+}
+
+static void Generate(World& world, const Profile& profile, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    int rows = world.GetRows();
+    int cols = world.GetCols();
+    int pitch = profile.blockPitch;
+
+    // Vertical roads with a sidewalk on their right
+    for (int x0 = 0; x0 < cols; x0 += pitch) {
+        for (int y = 0; y < rows; y += 2) Stamp(world, x0, y, TileType::Road);
+        for (int y = 0; y < rows; y++) Stamp(world, x0 + 2, y, TileType::Path);
+    }
+
+    // Horizontal roads or rail lines between block rows
+    for (int y0 = 0; y0 < rows; y0 += pitch) {
+        if (chance(rng) < profile.railRowShare) {
+            for (int x = 0; x < cols; x++) Stamp(world, x, y0, TileType::Track);
+        } else {
+            for (int x = 0; x < cols; x += 2) Stamp(world, x, y0, TileType::Road);
+            for (int x = 0; x < cols; x++) Stamp(world, x, y0 + 2, TileType::Path);
+        }
+    }
+
+    // Block interiors
+    for (int by = 0; by < rows; by += pitch) {
+        for (int bx = 0; bx < cols; bx += pitch) {
+            int x0 = bx + 3, y0 = by + 3;
+            int x1 = std::min(bx + pitch, cols), y1 = std::min(by + pitch, rows);
+            if (chance(rng) < profile.townShare) {
+                // Rows of 3x3 houses, each fronted by a path
+                for (int y = y0; y + 4 <= y1; y += 4) {
+                    for (int x = x0; x < x1; x++) Stamp(world, x, y + 3, TileType::Path);
+                    for (int x = x0; x + 3 <= x1; x += 3) {
+                        world.PlaceBuilding(static_cast<BuildingType>(1 + rng() % (BUILDING_TYPE_COUNT - 1)), x, y);
+                    }
+                }
+            } else {
+                for (int y = y0; y < y1; y++) {
+                    for (int x = x0; x < x1; x++) {
+                        double roll = chance(rng);
+                        if (roll < profile.pathNoise) Stamp(world, x, y, TileType::Path);
+                        else if (roll < profile.pathNoise * 1.02) {
+                            Stamp(world, x, y, TileType::TrackCorner, (float)(rng() % 4) * 90.0f);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Runs fn reps times and records the median and fastest, divided by count
+template <typename Fn>
+static void Time(std::vector<Result>& results, const Profile& profile, int size, const char* op,
+                 const char* unit, double scale, long count, int reps, Fn fn) {
+    std::vector<double> samples;
+    for (int r = 0; r < reps; r++) {
+        Clock::time_point start = Clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        samples.push_back(seconds * scale / count);
+    }
+    std::sort(samples.begin(), samples.end());
+    Result result = { profile.name, size, op, unit, samples[samples.size() / 2], samples[0], count };
+    fprintf(stderr, "  %-22s %12.3f %s\n", op, result.median, unit);
+    results.push_back(result);
+}
+
+// True if both graphs hold the same nodes and edges in the same order
+static bool SameGraph(const PathGraph& a, const PathGraph& b) {
+    const std::vector<PathNode>& nodesA = a.GetNodes();
+    const std::vector<PathNode>& nodesB = b.GetNodes();
+    if (nodesA.size() != nodesB.size()) return false;
+    for (size_t i = 0; i < nodesA.size(); i++) {
+        if (nodesA[i].x != nodesB[i].x || nodesA[i].y != nodesB[i].y ||
+            nodesA[i].firstEdge != nodesB[i].firstEdge || nodesA[i].edgeCount != nodesB[i].edgeCount) {
+            return false;
+        }
+    }
+    return a.GetEdgeTargets() == b.GetEdgeTargets() && a.GetEdgeCosts() == b.GetEdgeCosts();
+}
+
+// Returns false if a pooled path graph build differed from the serial one or
+// a save or load failed
+static bool RunWorld(const Profile& profile, int size, int reps, const std::vector<int>& threads,
+                     const fs::path& scratch, std::vector<Result>& results, std::vector<WorldInfo>& worlds) {
+    fprintf(stderr, "%s %dx%d\n", profile.name, size, size);
+    World world(size, size);
+
+    // Generation itself is timed once; it is setup, not a game operation
+    Clock::time_point start = Clock::now();
+    Generate(world, profile, 1);
+    double generateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    fprintf(stderr, "  %-22s %12.3f ms\n", "generate", generateMs);
+
+    Time(results, profile, size, "UpdateAllConnections", "ms", 1e3, 1, reps,
+         [&] { world.UpdateAllConnections(); });
+    Time(results, profile, size, "PathGraph::Build", "ms", 1e3, 1, reps,
+         [&] { world.RebuildPathGraph(); });
+    bool identical = true;
+    for (int threadCount : threads) {
+        WorkerPool pool(threadCount);
+        PathGraph graph;
+        std::string op = "PathGraph::Build/" + std::to_string(threadCount) + "t";
+        Time(results, profile, size, op.c_str(), "ms", 1e3, 1, reps,
+             [&] { graph.Build(world.GetTiles(), &pool); });
+        if (!SameGraph(graph, world.GetPathGraph())) {
+            fprintf(stderr, "lego_loco_bench: %s differs from the serial build\n", op.c_str());
+            identical = false;
+        }
+    }
+
+    // Follows every edge once through the CSR arrays, as a search over the graph does
+    const PathGraph& graph = world.GetPathGraph();
+    const std::vector<PathNode>& nodes = graph.GetNodes();
+    const std::vector<int>& edgeTargets = graph.GetEdgeTargets();
+    const std::vector<int>& edgeCosts = graph.GetEdgeCosts();
+    long edgeCount = 0;
+    for (const PathNode& node : nodes) edgeCount += node.edgeCount;
+    std::vector<int> depth(nodes.size());
+    std::vector<int> frontier;
+    frontier.reserve(nodes.size());
+    Time(results, profile, size, "PathGraph::Traverse", "ns", 1e9, std::max(1L, edgeCount), reps, [&] {
+        std::fill(depth.begin(), depth.end(), -1);
+        long costSum = 0;
+        for (size_t root = 0; root < nodes.size(); root++) {
+            if (depth[root] >= 0) continue;
+            depth[root] = 0;
+            frontier.clear();
+            frontier.push_back((int)root);
+            for (size_t head = 0; head < frontier.size(); head++) {
+                const PathNode& node = nodes[frontier[head]];
+                for (int e = node.firstEdge; e < node.firstEdge + node.edgeCount; e++) {
+                    costSum += edgeCosts[e];
+                    int target = edgeTargets[e];
+                    if (depth[target] >= 0) continue;
+                    depth[target] = depth[frontier[head]] + 1;
+                    frontier.push_back(target);
+                }
+            }
+        }
+        benchSink = costSum;
+    });
+
+    WorldInfo info = { profile.name, size, 0, (long)world.GetBuildings().size(),
+                       (long)world.GetPathGraph().GetNodes().size(), 0 };
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if (world.GetTile(x, y).type != TileType::Empty) info.tiles++;
+        }
+    }
+    for (const PathNode& node : world.GetPathGraph().GetNodes()) info.pathEdges += node.edgeCount;
+    worlds.push_back(info);
+
+    // Random 3x3 footprints, a mix of free and blocked spots
+    std::vector<Placeable> queries(1024);
+    std::mt19937 rng(2);
+    for (Placeable& p : queries) {
+        p.gridX = (int)(rng() % size) - 1;
+        p.gridY = (int)(rng() % size) - 1;
+        p.width = 3;
+        p.height = 3;
+    }
+    Time(results, profile, size, "CanPlace", "ns", 1e9, CAN_PLACE_QUERIES, reps, [&] {
+        long placeable = 0;
+        for (int i = 0; i < CAN_PLACE_QUERIES; i++) placeable += world.CanPlace(queries[i & 1023]);
+        benchSink = placeable;
+    });
+
+    // Random pairs of path cells, each query timed on its own
+    std::vector<GridPos> pathCells;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if (world.GetTile(x, y).type == TileType::Path) pathCells.push_back({ x, y });
+        }
+    }
+    if (!pathCells.empty()) {
+        std::vector<double> p50s, p99s;
+        std::vector<GridPos> path;
+        for (int r = 0; r < reps; r++) {
+            std::vector<double> samples;
+            long found = 0;
+            for (int i = 0; i < FIND_PATH_QUERIES; i++) {
+                GridPos from = pathCells[rng() % pathCells.size()];
+                GridPos to = pathCells[rng() % pathCells.size()];
+                Clock::time_point queryStart = Clock::now();
+                found += world.FindPath(from, to, path);
+                samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - queryStart).count());
+            }
+            benchSink = found;
+            std::sort(samples.begin(), samples.end());
+            p50s.push_back(samples[samples.size() / 2]);
+            p99s.push_back(samples[samples.size() * 99 / 100]);
+        }
+        std::sort(p50s.begin(), p50s.end());
+        std::sort(p99s.begin(), p99s.end());
+        Result p50 = { profile.name, size, "FindPath/p50", "us", p50s[p50s.size() / 2], p50s[0], 1 };
+        Result p99 = { profile.name, size, "FindPath/p99", "us", p99s[p99s.size() / 2], p99s[0], 1 };
+        for (const Result& result : { p50, p99 }) {
+            fprintf(stderr, "  %-22s %12.3f %s\n", result.op.c_str(), result.median, result.unit);
+            results.push_back(result);
+        }
+    }
+
+    // Timings of failed saves or loads mean nothing, so a failure fails the run
+    SaveFileHandler saveHandler;
+    World loaded(size, size);
+    bool saved = true;
+    bool loadedOk = true;
+    fs::path binaryPath = scratch / "bench.loco";
+    Time(results, profile, size, "Save", "ms", 1e3, 1, reps,
+         [&] { saved &= saveHandler.Save(world, binaryPath.string()); });
+    Time(results, profile, size, "Load", "ms", 1e3, 1, reps,
+         [&] { loadedOk &= saveHandler.Load(loaded, binaryPath.string()); });
+    fs::remove(binaryPath);
+    if (size <= MAX_JSON_SIZE) {
+        fs::path jsonPath = scratch / "bench.json";
+        Time(results, profile, size, "SaveJson", "ms", 1e3, 1, reps,
+             [&] { saved &= saveHandler.Save(world, jsonPath.string()); });
+        Time(results, profile, size, "LoadJson", "ms", 1e3, 1, reps,
+             [&] { loadedOk &= saveHandler.Load(loaded, jsonPath.string()); });
+        fs::remove(jsonPath);
+    }
+    if (!saved) {
+        fprintf(stderr, "lego_loco_bench: cannot write saves to %s\n", scratch.string().c_str());
+        return false;
+    }
+    if (!loadedOk) {
+        fprintf(stderr, "lego_loco_bench: %s\n", saveHandler.GetLastError().c_str());
+        return false;
+    }
+
+    // Last, since it changes the map: edits as a player makes them, each
+    // patching connections and the path graph around it
+    std::mt19937 editRng(3);
+    const TileType editTypes[] = { TileType::Path, TileType::Path, TileType::Road, TileType::Track, TileType::Empty };
+    Time(results, profile, size, "SetTile", "us", 1e6, SET_TILE_EDITS, reps, [&] {
+        for (int i = 0; i < SET_TILE_EDITS; i++) {
+            int x = (int)(editRng() % size);
+            int y = (int)(editRng() % size);
+            world.SetTile(x, y, editTypes[editRng() % 5], (float)(editRng() % 4) * 90.0f);
+        }
+    });
+    return identical;
+}
+
+static std::string JsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+static std::vector<std::string> SplitList(const char* text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> sizes = { 64, 256, 1024, 4096 };
+    std::vector<const Profile*> profiles;
+    std::vector<int> threads = { 1, 2, 4, 8 };
+    int reps = 3;
+    std::string label;
+    std::string outPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            for (const std::string& item : SplitList(argv[++i])) sizes.push_back(std::max(16, atoi(item.c_str())));
+        } else if (arg == "--profiles" && hasValue) {
+            for (const std::string& item : SplitList(argv[++i])) {
+                const Profile* match = nullptr;
+                for (const Profile& profile : PROFILES) {
+                    if (item == profile.name) match = &profile;
+                }
+                if (!match) {
+                    fprintf(stderr, "lego_loco_bench: unknown profile %s\n", item.c_str());
+                    return 2;
+                }
+                profiles.push_back(match);
+            }
+        } else if (arg == "--threads" && hasValue) {
+            threads.clear();
+            for (const std::string& item : SplitList(argv[++i])) threads.push_back(std::max(1, atoi(item.c_str())));
+        } else if (arg == "--reps" && hasValue) {
+            reps = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--label" && hasValue) {
+            label = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: lego_loco_bench [--sizes 64,256,1024,4096] [--profiles mixed,town]\n"
+                            "                       [--threads 1,2,4,8] [--reps N] [--label TEXT] [--out FILE]\n");
+            return 2;
+        }
+    }
+    if (profiles.empty()) {
+        for (const Profile& profile : PROFILES) profiles.push_back(&profile);
+    }
+
+    std::error_code error;
+    fs::path scratch = fs::temp_directory_path(error) / ("lego_loco_bench_" + std::to_string(Clock::now().time_since_epoch().count()));
+    if (!fs::create_directories(scratch, error)) {
+        fprintf(stderr, "lego_loco_bench: cannot create %s\n", scratch.string().c_str());
+        return 1;
+    }
+
+    std::vector<Result> results;
+    std::vector<WorldInfo> worlds;
+    bool passed = true;
+    for (const Profile* profile : profiles) {
+        for (int size : sizes) passed &= RunWorld(*profile, size, reps, threads, scratch, results, worlds);
+    }
+    fs::remove_all(scratch, error);
+
+    FILE* out = outPath.empty() ? stdout : fopen(outPath.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "lego_loco_bench: cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    fprintf(out, "{\n  \"label\": \"%s\",\n  \"reps\": %d,\n  \"worlds\": [\n", JsonEscape(label).c_str(), reps);
+    for (size_t i = 0; i < worlds.size(); i++) {
+        const WorldInfo& w = worlds[i];
+        fprintf(out, "    {\"profile\": \"%s\", \"size\": %d, \"tiles\": %ld, \"buildings\": %ld, "
+                     "\"pathNodes\": %ld, \"pathEdges\": %ld}%s\n",
+                w.profile.c_str(), w.size, w.tiles, w.buildings, w.pathNodes, w.pathEdges,
+                i + 1 < worlds.size() ? "," : "");
+    }
+    fprintf(out, "  ],\n  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        fprintf(out, "    {\"profile\": \"%s\", \"size\": %d, \"op\": \"%s\", \"unit\": \"%s\", "
+                     "\"median\": %.6g, \"min\": %.6g, \"count\": %ld}%s\n",
+                r.profile.c_str(), r.size, r.op.c_str(), r.unit, r.median, r.min, r.count,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    if (out != stdout) fclose(out);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// Runs the game logic without a window, for profiling on machines without a
+// display. Loads a save (or starts empty), runs simulation ticks and random
+// edits, and prints how long each step took:
+//   lego_loco_headless [--size ROWSxCOLS] [--ticks N] [--edits N] [--seed N]
+//                      [--verify N] [--save OUT] [save]
+// The world is ROWSxCOLS (default 4096x4096, the game's map); a save of another
+// size loads its overlap. --verify N compares the incrementally patched path
+// graph with a full rebuild every N edits and fails on the first mismatch.
+#include "World.h"
+#include "SaveFileHandler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void Usage() {
+    fprintf(stderr, "usage: lego_loco_headless [--size ROWSxCOLS] [--ticks N] [--edits N] [--seed N]\n"
+                    "                          [--verify N] [--save OUT] [save]\n");
+}
+
+// One random edit, weighted towards what a player places most
+static bool RandomEdit(World& world, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::uniform_int_distribution<int> cellX(0, world.GetCols() - 1);
+    std::uniform_int_distribution<int> cellY(0, world.GetRows() - 1);
+    int x = cellX(rng);
+    int y = cellY(rng);
+    float rotation = (float)(pick(rng) % 4) * 90.0f;
+
+    int roll = pick(rng);
+    if (roll < 35) return world.SetTile(x, y, TileType::Path);
+    if (roll < 50) return world.SetTile(x, y, TileType::Road);
+    if (roll < 65) return world.SetTile(x, y, TileType::Track, rotation);
+    if (roll < 70) return world.SetTile(x, y, TileType::TrackCorner, rotation);
+    if (roll < 85) return world.SetTile(x, y, TileType::Empty);
+    if (roll < 95) {
+        BuildingType type = static_cast<BuildingType>(1 + pick(rng) % (BUILDING_TYPE_COUNT - 1));
+        return world.PlaceBuilding(type, x, y);
+    }
+    const std::vector<Building>& buildings = world.GetBuildings();
+    if (buildings.empty()) return false;
+    const Building& b = buildings[pick(rng) % buildings.size()];
+    return world.RemoveBuilding(b.gridX, b.gridY);
+}
+
+static double Percentile(std::vector<double>& samples, double fraction) {
+    if (samples.empty()) return 0.0;
+    size_t index = std::min(samples.size() - 1, (size_t)(fraction * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+int main(int argc, char** argv) {
+    int rows = 4096;
+    int cols = 4096;
+    long ticks = 0;
+    long edits = 0;
+    unsigned seed = 1;
+    long verifyEvery = 0;
+    std::string loadPath;
+    std::string savePath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &rows, &cols) != 2 || rows <= 0 || cols <= 0) {
+                Usage();
+                return 2;
+            }
+        }
+        else if (arg == "--ticks" && hasValue) ticks = atol(argv[++i]);
+        else if (arg == "--edits" && hasValue) edits = atol(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = (unsigned)atol(argv[++i]);
+        else if (arg == "--verify" && hasValue) verifyEvery = atol(argv[++i]);
+        else if (arg == "--save" && hasValue) savePath = argv[++i];
+        else if (arg[0] != '-' && loadPath.empty()) loadPath = arg;
+        else {
+            Usage();
+            return 2;
+        }
+    }
+
+    Clock::time_point start = Clock::now();
+    World world(rows, cols);
+    printf("World %dx%d created in %.2f ms\n", rows, cols, MillisecondsSince(start));
+
+    SaveFileHandler saveHandler;
+    if (!loadPath.empty()) {
+        start = Clock::now();
+        if (!saveHandler.Load(world, loadPath)) {
+            fprintf(stderr, "lego_loco_headless: %s\n", saveHandler.GetLastError().c_str());
+            return 1;
+        }
+        printf("Loaded %s in %.2f ms: %zu buildings, %zu path nodes\n", loadPath.c_str(), MillisecondsSince(start),
+               world.GetBuildings().size(), world.GetPathGraph().GetNodes().size());
+    }
+
+    if (ticks > 0) {
+        start = Clock::now();
+        for (long i = 0; i < ticks; i++) world.Tick();
+        double ms = MillisecondsSince(start);
+        printf("%ld ticks in %.2f ms (%.3f us/tick)\n", ticks, ms, ms * 1000.0 / ticks);
+    }
+
+    if (edits > 0) {
+        std::mt19937 rng(seed);
+        std::vector<double> samples;
+        samples.reserve((size_t)edits);
+        long applied = 0;
+        double total = 0.0;
+        for (long i = 1; i <= edits; i++) {
+            start = Clock::now();
+            if (RandomEdit(world, rng)) applied++;
+            double ms = MillisecondsSince(start);
+            samples.push_back(ms);
+            total += ms;
+
+            if (verifyEvery > 0 && (i % verifyEvery == 0 || i == edits)) {
+                PathGraph rebuilt;
+                rebuilt.Build(world.GetTiles());
+                if (!world.GetPathGraph().Matches(rebuilt)) {
+                    fprintf(stderr, "lego_loco_headless: path graph differs from a full rebuild after edit %ld (seed %u)\n",
+                            i, seed);
+                    return 1;
+                }
+            }
+        }
+        double maxMs = *std::max_element(samples.begin(), samples.end());
+        double p99 = Percentile(samples, 0.99);
+        double p50 = Percentile(samples, 0.50);
+        printf("%ld edits (%ld changed the world) in %.2f ms: mean %.4f ms, p50 %.4f, p99 %.4f, max %.4f\n",
+               edits, applied, total, total / edits, p50, p99, maxMs);
+        if (verifyEvery > 0) printf("Path graph matched a full rebuild every %ld edits\n", verifyEvery);
+    }
+
+    start = Clock::now();
+    PathGraph rebuilt;
+    rebuilt.Build(world.GetTiles());
+    printf("Full path graph build: %.2f ms, %zu nodes\n", MillisecondsSince(start), rebuilt.GetNodes().size());
+    printf("Grid storage: %.1f KB, %zu of %d tile chunks allocated\n", world.GetGridMemoryBytes() / 1024.0,
+           world.GetTiles().GetChunkCount(), world.GetTiles().GetChunkRows() * world.GetTiles().GetChunkCols());
+
+    if (!savePath.empty()) {
+        start = Clock::now();
+        if (!saveHandler.Save(world, savePath)) {
+            fprintf(stderr, "lego_loco_headless: cannot write %s\n", savePath.c_str());
+            return 1;
+        }
+        printf("Saved %s in %.2f ms\n", savePath.c_str(), MillisecondsSince(start));
+    }
+    return 0;
+}
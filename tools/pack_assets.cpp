@@ -0,0 +1,28 @@
+// Bakes every game sprite into one asset pack: magenta keying, frame slicing
+// and atlas packing happen here instead of at startup. Run from the repository
+// root (the source paths are relative to it):
+//   pack_assets [output]    default output: resources/assets.pack
+#include "raylib.h"
+#include "AssetPack.h"
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv) {
+    std::string output = argc > 1 ? argv[1] : AssetPack::DEFAULT_PATH;
+    SetTraceLogLevel(LOG_WARNING);
+
+    AssetPack pack;
+    if (!pack.LoadSources()) {
+        fprintf(stderr, "pack_assets: %s\n", pack.GetLastError().c_str());
+        return 1;
+    }
+    for (const std::string& path : pack.GetSkipped()) {
+        fprintf(stderr, "pack_assets: warning: %s not found, packing without it\n", path.c_str());
+    }
+    if (!pack.Write(output)) {
+        fprintf(stderr, "pack_assets: cannot write %s\n", output.c_str());
+        return 1;
+    }
+    printf("%s: %d sprites on %d pages\n", output.c_str(), pack.GetSpriteCount(), pack.GetPageCount());
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Checks the path graph against reference results on random maps and exits 1
+// on the first mismatch (run by `make check` and ctest):
+//   path_graph_check [--seeds N] [--edits N] [--size N]
+// After every random edit the incrementally patched graph must match a full
+// rebuild of the same tiles, and FindPath must agree with a breadth-first
+// search over the path tiles.
+#include "World.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+// Dense enough in paths that edits keep splitting and joining corridors
+static bool RandomEdit(World& world, std::mt19937& rng) {
+    int x = (int)(rng() % world.GetCols());
+    int y = (int)(rng() % world.GetRows());
+    int roll = (int)(rng() % 100);
+    if (roll < 50) return world.SetTile(x, y, TileType::Path);
+    if (roll < 75) return world.SetTile(x, y, TileType::Empty);
+    if (roll < 85) return world.SetTile(x, y, TileType::Road);
+    if (roll < 93) return world.SetTile(x, y, TileType::Track, (float)(rng() % 4) * 90.0f);
+    if (roll < 97) return world.PlaceBuilding(BuildingType::House, x, y);
+    return world.RemoveBuilding(x, y);
+}
+
+static bool IsPathTile(const World& world, int x, int y) {
+    return x >= 0 && y >= 0 && x < world.GetCols() && y < world.GetRows() &&
+           world.GetTile(x, y).type == TileType::Path;
+}
+
+// Steps from 'from' to 'to' over 4-adjacent path tiles, or -1 if unreachable
+static int BreadthFirstDistance(const World& world, GridPos from, GridPos to) {
+    if (!IsPathTile(world, from.x, from.y) || !IsPathTile(world, to.x, to.y)) return -1;
+    int cols = world.GetCols();
+    std::vector<int> distance((size_t)cols * world.GetRows(), -1);
+    std::queue<GridPos> frontier;
+    distance[(size_t)from.y * cols + from.x] = 0;
+    frontier.push(from);
+    const int dx[4] = { 0, 1, 0, -1 };
+    const int dy[4] = { -1, 0, 1, 0 };
+    while (!frontier.empty()) {
+        GridPos cur = frontier.front();
+        frontier.pop();
+        int d = distance[(size_t)cur.y * cols + cur.x];
+        if (cur.x == to.x && cur.y == to.y) return d;
+        for (int i = 0; i < 4; i++) {
+            int x = cur.x + dx[i], y = cur.y + dy[i];
+            if (!IsPathTile(world, x, y) || distance[(size_t)y * cols + x] >= 0) continue;
+            distance[(size_t)y * cols + x] = d + 1;
+            frontier.push({ x, y });
+        }
+    }
+    return -1;
+}
+
+// FindPath must find a route exactly when one exists, as short as the
+// breadth-first one, running tile by tile over paths from 'from' to 'to'
+static bool CheckPath(World& world, GridPos from, GridPos to, const char* context) {
+    std::vector<GridPos> path;
+    bool found = world.FindPath(from, to, path);
+    int expected = BreadthFirstDistance(world, from, to);
+    const char* problem = nullptr;
+    if (found != (expected >= 0)) problem = found ? "found a route where there is none" : "missed a route";
+    else if (found && (int)path.size() != expected + 1) problem = "returned a longer route than needed";
+    else if (found && (path.front().x != from.x || path.front().y != from.y ||
+                       path.back().x != to.x || path.back().y != to.y)) {
+        problem = "returned a route with the wrong ends";
+    }
+    for (size_t i = 0; !problem && i < path.size(); i++) {
+        if (!IsPathTile(world, path[i].x, path[i].y)) problem = "left the paths";
+        else if (i > 0 && abs(path[i].x - path[i - 1].x) + abs(path[i].y - path[i - 1].y) != 1) {
+            problem = "skipped a tile";
+        }
+    }
+    if (problem) {
+        fprintf(stderr, "path_graph_check: FindPath (%d,%d) -> (%d,%d) %s (%s)\n",
+                from.x, from.y, to.x, to.y, problem, context);
+        return false;
+    }
+    return true;
+}
+
+// Hand-built maps for the cases random maps rarely hit exactly
+static bool CheckPathCases() {
+    World world(32, 32);
+    // Two straight corridors with dead ends and a corridor joining them at a T
+    for (int x = 2; x <= 20; x++) world.SetTile(x, 5, TileType::Path);
+    for (int x = 2; x <= 20; x++) world.SetTile(x, 12, TileType::Path);
+    for (int y = 6; y <= 11; y++) world.SetTile(10, y, TileType::Path);
+    // An isolated corridor
+    for (int y = 20; y <= 28; y++) world.SetTile(25, y, TileType::Path);
+
+    std::vector<GridPos> path;
+    bool ok = CheckPath(world, { 4, 5 }, { 8, 5 }, "same corridor") &&
+              CheckPath(world, { 8, 5 }, { 4, 5 }, "same corridor, reversed") &&
+              CheckPath(world, { 12, 5 }, { 18, 5 }, "same corridor past a junction") &&
+              CheckPath(world, { 7, 5 }, { 7, 5 }, "start == goal mid-corridor") &&
+              CheckPath(world, { 10, 5 }, { 10, 5 }, "start == goal on a node") &&
+              CheckPath(world, { 3, 5 }, { 18, 12 }, "across the junction") &&
+              CheckPath(world, { 10, 8 }, { 2, 12 }, "from the joining corridor") &&
+              CheckPath(world, { 5, 5 }, { 25, 24 }, "unreachable") &&
+              CheckPath(world, { 25, 24 }, { 25, 20 }, "isolated corridor") &&
+              CheckPath(world, { 0, 0 }, { 5, 5 }, "start off the paths");
+    if (!ok) return false;
+    if (!world.FindPath({ 7, 5 }, { 7, 5 }, path) || path.size() != 1) {
+        fprintf(stderr, "path_graph_check: FindPath from a tile to itself should return just that tile\n");
+        return false;
+    }
+
+    // Cut the joining corridor: the cached route across it must go
+    world.SetTile(10, 8, TileType::Empty);
+    ok = CheckPath(world, { 3, 5 }, { 18, 12 }, "after cutting the junction") &&
+         CheckPath(world, { 10, 7 }, { 10, 5 }, "onto the new dead end");
+    world.SetTile(10, 8, TileType::Path);
+    return ok && CheckPath(world, { 3, 5 }, { 18, 12 }, "after rejoining the junction");
+}
+
+static GridPos RandomCell(const World& world, std::mt19937& rng) {
+    return { (int)(rng() % world.GetCols()), (int)(rng() % world.GetRows()) };
+}
+
+// Mostly path cells, so most queries search rather than fail up front
+static GridPos RandomEndpoint(const World& world, std::mt19937& rng) {
+    GridPos cell = RandomCell(world, rng);
+    for (int tries = 0; tries < 32 && !IsPathTile(world, cell.x, cell.y); tries++) cell = RandomCell(world, rng);
+    return cell;
+}
+
+static bool CheckIncremental(unsigned seed, int size, int edits) {
+    World world(size, size);
+    std::mt19937 rng(seed);
+    GridPos from = { 0, 0 }, to = { 0, 0 };
+    for (int i = 1; i <= edits; i++) {
+        RandomEdit(world, rng);
+        PathGraph rebuilt;
+        rebuilt.Build(world.GetTiles());
+        if (!world.GetPathGraph().Matches(rebuilt)) {
+            fprintf(stderr, "path_graph_check: incremental graph differs from a full rebuild after edit %d (seed %u)\n",
+                    i, seed);
+            return false;
+        }
+
+        // Ask the previous query again, through the cache the edit should have
+        // cleared, then a new one
+        std::string context = "edit " + std::to_string(i) + ", seed " + std::to_string(seed);
+        if (!CheckPath(world, from, to, context.c_str())) return false;
+        from = RandomEndpoint(world, rng);
+        to = rng() % 16 == 0 ? from : RandomEndpoint(world, rng);
+        if (!CheckPath(world, from, to, context.c_str())) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int seeds = 20;
+    int edits = 2000;
+    int size = 48;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seeds" && hasValue) seeds = std::max(1, atoi(argv[++i]));
+        else if (arg == "--edits" && hasValue) edits = std::max(1, atoi(argv[++i]));
+        else if (arg == "--size" && hasValue) size = std::max(8, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "usage: path_graph_check [--seeds N] [--edits N] [--size N]\n");
+            return 2;
+        }
+    }
+
+    if (!CheckPathCases()) return 1;
+    for (int seed = 1; seed <= seeds; seed++) {
+        if (!CheckIncremental((unsigned)seed, size, edits)) return 1;
+    }
+    printf("Incremental path graph and FindPath matched the references after each of %d edits on %d maps\n",
+           edits, seeds);
+    return 0;
+}
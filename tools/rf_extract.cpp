@@ -0,0 +1,324 @@
+// Extracts the original game's resource.RFH/resource.RFD archive, producing
+// the same files as tools/rf-extract.py:
+//   rf_extract [-j threads] [-v] [-o outdir] [resource.RFH [resource.RFD]]
+// Files are written to <outdir>/resource_rfd/<name> (outdir defaults to ".").
+//
+// RFH is a list of {uint32 nameLength, name (nameLength bytes, NUL last),
+// uint32 size, uint32 flags}; the file contents follow each other in RFD.
+// Flag bit 0 marks Huffman-compressed files, which carry their own tree:
+// uint16 root at offset 4, then 4-byte nodes {uint16 child0, child1} from
+// offset 8 (node n at 8 + n * 4), and the code bits, LSB first, from 0x808.
+// Children without bit 0x100 set are output bytes; decoding restarts at the
+// root after each and runs to the last bit of the file.
+#include "MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct ArchiveEntry {
+    std::string name;     // UTF-8, '/' separated, "resource_rfd/" prefixed
+    const unsigned char* data;
+    size_t size;          // bytes present in RFD (short if RFD is truncated)
+    uint32_t flags;
+};
+
+static uint32_t ReadU32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Names are raw bytes; the Python script reads them as Latin-1 and the OS stores them as UTF-8
+static std::string Latin1ToUtf8(const unsigned char* p, size_t length) {
+    std::string out;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = p[i];
+        if (c == '\\') c = '/';
+        if (c < 0x80) {
+            out += (char)c;
+        } else {
+            out += (char)(0xC0 | (c >> 6));
+            out += (char)(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+
+// Mirrors the script's header walk: it stops at the first record whose length
+// field doesn't fit, and reads each file right after the previous one
+static bool ParseHeader(const MappedFile& rfh, const MappedFile& rfd, std::vector<ArchiveEntry>& entries) {
+    const unsigned char* h = rfh.Data();
+    size_t hsize = rfh.Size();
+    size_t pos = 0;
+    uint64_t filePos = 0;
+
+    while (pos + 4 <= hsize) {
+        uint32_t nameLength = ReadU32(h + pos);
+        pos += 4;
+        size_t chars = nameLength > 0 ? nameLength - 1 : 0;
+        if (chars > hsize - pos || hsize - pos - chars < 9) {
+            fprintf(stderr, "rf_extract: header record at %zu runs past the end of the file\n", pos - 4);
+            return false;
+        }
+        std::string name = "resource_rfd/" + Latin1ToUtf8(h + pos, chars);
+        pos += chars + 1;
+        uint32_t size = ReadU32(h + pos);
+        uint32_t flags = ReadU32(h + pos + 4);
+        pos += 8;
+
+        size_t present = 0;
+        if (filePos < rfd.Size()) present = (size_t)std::min<uint64_t>(size, rfd.Size() - filePos);
+        entries.push_back({ name, rfd.Data() + std::min<uint64_t>(filePos, rfd.Size()), present, flags });
+        filePos += present;
+    }
+    return true;
+}
+
+// Buffered writer so decoded bytes go straight to disk in blocks
+class OutputStream {
+private:
+    FILE* file = nullptr;
+    unsigned char buffer[1 << 16];
+    size_t used = 0;
+    bool failed = false;
+
+public:
+    bool Open(const fs::path& path) {
+#ifdef _WIN32
+        file = _wfopen(path.c_str(), L"wb");
+#else
+        file = fopen(path.c_str(), "wb");
+#endif
+        return file != nullptr;
+    }
+
+    void Put(unsigned char byte) {
+        if (used == sizeof(buffer)) Flush();
+        buffer[used++] = byte;
+    }
+
+    void Write(const unsigned char* data, size_t size) {
+        Flush();
+        if (size > 0 && fwrite(data, 1, size, file) != size) failed = true;
+    }
+
+    void Flush() {
+        if (used > 0 && fwrite(buffer, 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+    bool Close() {
+        Flush();
+        if (fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+};
+
+// Decodes TABLE_BITS bits at a time from the root: each table entry holds the
+// byte a code of up to TABLE_BITS bits decodes to, or the node reached after
+// TABLE_BITS bits, from where longer codes continue one bit at a time.
+class HuffmanDecoder {
+private:
+    static const int TABLE_BITS = 10;
+    static const size_t DATA_START = 0x808;
+
+    struct TableEntry {
+        uint16_t value;  // output byte or internal node
+        uint8_t bits;    // bits consumed, 0 = take the bitwise path
+        bool leaf;
+    };
+
+    const unsigned char* data;
+    size_t size;
+    uint16_t root = 0;
+    TableEntry table[1 << TABLE_BITS];
+
+    // False where the script would fail reading past the end of the file
+    bool Child(uint16_t node, unsigned bit, uint16_t& child) const {
+        size_t offset = (size_t)node * 4 + bit * 2 + 8;
+        if (offset + 2 > size) return false;
+        child = (uint16_t)(data[offset] | (data[offset + 1] << 8));
+        return true;
+    }
+
+    void BuildTable() {
+        for (unsigned index = 0; index < (1u << TABLE_BITS); index++) {
+            TableEntry entry = { 0, 0, false };
+            uint16_t node = root;
+            int bits = 0;
+            bool valid = true;
+            while (bits < TABLE_BITS) {
+                if (!Child(node, (index >> bits) & 1, node)) { valid = false; break; }
+                bits++;
+                if ((node & 0x100) == 0) {
+                    entry.leaf = true;
+                    valid = node < 0x100;
+                    break;
+                }
+            }
+            if (valid) {
+                entry.value = node;
+                entry.bits = (uint8_t)bits;
+            }
+            table[index] = entry;
+        }
+    }
+
+public:
+    HuffmanDecoder(const unsigned char* data, size_t size) : data(data), size(size) {}
+
+    bool Decode(OutputStream& out) {
+        if (size < 6) return false;
+        root = (uint16_t)(data[4] | (data[5] << 8));
+        if (size <= DATA_START) return true;
+        BuildTable();
+
+        const unsigned char* in = data + DATA_START;
+        size_t remaining = size - DATA_START;
+        uint64_t bitBuffer = 0;
+        int available = 0;
+        uint16_t node = root;
+
+        for (;;) {
+            while (available <= 56 && remaining > 0) {
+                bitBuffer |= (uint64_t)*in++ << available;
+                available += 8;
+                remaining--;
+            }
+            if (available == 0) break;
+
+            // The table is anchored at the root, wherever the walk came from
+            if (node == root && available >= TABLE_BITS) {
+                const TableEntry& entry = table[bitBuffer & ((1u << TABLE_BITS) - 1)];
+                if (entry.bits > 0) {
+                    bitBuffer >>= entry.bits;
+                    available -= entry.bits;
+                    if (entry.leaf) out.Put((unsigned char)entry.value);
+                    else node = entry.value;
+                    continue;
+                }
+            }
+
+            unsigned bit = bitBuffer & 1;
+            bitBuffer >>= 1;
+            available--;
+            if (!Child(node, bit, node)) return false;
+            if ((node & 0x100) == 0) {
+                if (node > 0xFF) return false;
+                out.Put((unsigned char)node);
+                node = root;
+            }
+        }
+        return true;
+    }
+};
+
+static bool ExtractEntry(const ArchiveEntry& entry, const fs::path& outDir) {
+    OutputStream out;
+    if (!out.Open(outDir / fs::u8path(entry.name))) return false;
+    bool ok = true;
+    if (entry.flags & 1) {
+        HuffmanDecoder decoder(entry.data, entry.size);
+        ok = decoder.Decode(out);
+    } else {
+        out.Write(entry.data, entry.size);
+    }
+    return out.Close() && ok;
+}
+
+int main(int argc, char** argv) {
+    std::string rfhPath = "resource.RFH";
+    std::string rfdPath = "resource.RFD";
+    fs::path outDir = ".";
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    bool verbose = false;
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) threadCount = std::max(1, atoi(argv[++i]));
+        else if (arg == "-o" && i + 1 < argc) outDir = argv[++i];
+        else if (arg == "-v") verbose = true;
+        else if (positional == 0) { rfhPath = arg; positional++; }
+        else if (positional == 1) { rfdPath = arg; positional++; }
+        else {
+            fprintf(stderr, "usage: rf_extract [-j threads] [-v] [-o outdir] [resource.RFH [resource.RFD]]\n");
+            return 2;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MappedFile rfh, rfd;
+    if (!rfh.Open(rfhPath)) {
+        fprintf(stderr, "rf_extract: cannot open %s\n", rfhPath.c_str());
+        return 1;
+    }
+    // An empty RFD is valid (every file is then empty), but can't be mapped
+    bool haveData = rfd.Open(rfdPath);
+    if (!haveData && !fs::exists(rfdPath)) {
+        fprintf(stderr, "rf_extract: cannot open %s\n", rfdPath.c_str());
+        return 1;
+    }
+
+    std::vector<ArchiveEntry> entries;
+    bool headerOk = ParseHeader(rfh, rfd, entries);
+
+    // The script writes files in order, so a repeated name ends up with its last contents
+    std::vector<size_t> work;
+    {
+        std::vector<std::pair<std::string, size_t>> byName;
+        for (size_t i = 0; i < entries.size(); i++) byName.emplace_back(entries[i].name, i);
+        std::stable_sort(byName.begin(), byName.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (size_t i = 0; i < byName.size(); i++) {
+            if (i + 1 < byName.size() && byName[i + 1].first == byName[i].first) continue;
+            work.push_back(byName[i].second);
+        }
+    }
+
+    // Directories first, so workers never race to create them
+    std::error_code error;
+    for (size_t index : work) {
+        fs::create_directories((outDir / fs::u8path(entries[index].name)).parent_path(), error);
+    }
+
+    // Largest first keeps the threads evenly loaded
+    std::sort(work.begin(), work.end(), [&](size_t a, size_t b) { return entries[a].size > entries[b].size; });
+
+    std::atomic<size_t> next{0};
+    std::atomic<int> failures{0};
+    std::mutex logMutex;
+    auto worker = [&]() {
+        for (size_t i = next++; i < work.size(); i = next++) {
+            const ArchiveEntry& entry = entries[work[i]];
+            bool ok = ExtractEntry(entry, outDir);
+            if (!ok) failures++;
+            if (!ok || verbose) {
+                std::lock_guard<std::mutex> lock(logMutex);
+                fprintf(ok ? stdout : stderr, "%-30s, Size: %8zu bytes, Flags: %u%s\n",
+                        entry.name.c_str(), entry.size, entry.flags, ok ? "" : " (failed)");
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threadCount = (unsigned)std::min<size_t>(threadCount, std::max<size_t>(work.size(), 1));
+    for (unsigned t = 1; t < threadCount; t++) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    int failed = failures.load();
+    printf("Extracted %zu files in %.3f s on %u threads", work.size() - (size_t)failed, seconds, threadCount);
+    if (failed > 0) printf(", %d failed", failed);
+    printf("\n");
+    return (headerOk && failed == 0) ? 0 : 1;
+}
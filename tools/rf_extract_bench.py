@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Compare rf-extract.py with the native rf_extract: run both on one archive,
+time them and check that they write byte-identical files.
+
+Without --rfh/--rfd a synthetic archive is generated in the same format
+(Huffman-compressed and stored files in nested folders), so the comparison
+does not need the original game files.
+"""
+
+import argparse
+import filecmp
+import heapq
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+TOOLS = Path(__file__).parent.absolute()
+
+
+def huff_compress(data):
+    """Encode data the way the game's archive stores it (see rf_extract.cpp)."""
+    freq = {}
+    for b in data:
+        freq[b] = freq.get(b, 0) + 1
+    # A tree needs two leaves
+    for filler in (0, 1):
+        if len(freq) >= 2:
+            break
+        freq.setdefault(filler, 0)
+
+    heap = [(count, i, sym) for i, (sym, count) in enumerate(sorted(freq.items()))]
+    heapq.heapify(heap)
+    children = {}
+    next_node = 0x100
+    order = len(heap)
+    while len(heap) > 1:
+        c0, _, n0 = heapq.heappop(heap)
+        c1, _, n1 = heapq.heappop(heap)
+        children[next_node] = (n0, n1)
+        heapq.heappush(heap, (c0 + c1, order, next_node))
+        order += 1
+        next_node += 1
+    root = heap[0][2]
+
+    codes = {}
+    stack = [(root, [])]
+    while stack:
+        node, path = stack.pop()
+        if node < 0x100:
+            codes[node] = path
+        else:
+            stack.append((children[node][0], path + [0]))
+            stack.append((children[node][1], path + [1]))
+
+    out = bytearray(0x808)
+    struct.pack_into("<IH", out, 0, len(data), root)
+    for node, (n0, n1) in children.items():
+        struct.pack_into("<HH", out, 8 + node * 4, n0, n1)
+
+    acc = 0
+    nbits = 0
+    for b in data:
+        for bit in codes[b]:
+            acc |= bit << nbits
+            nbits += 1
+            if nbits == 8:
+                out.append(acc)
+                acc = 0
+                nbits = 0
+    if nbits:
+        out.append(acc)
+    return bytes(out)
+
+
+def make_archive(directory, files, avg_size, seed):
+    rng = random.Random(seed)
+    words = [bytes(rng.randrange(32, 127) for _ in range(rng.randrange(2, 9))) for _ in range(300)]
+    header = bytearray()
+    blob = bytearray()
+    for i in range(files):
+        size = max(1, int(rng.expovariate(1.0 / avg_size)))
+        data = bytearray()
+        while len(data) < size:
+            data += rng.choice(words) + b" "
+        data = bytes(data[:size])
+        compressed = rng.random() < 0.8
+        stored = huff_compress(data) if compressed else data
+        name = f"dir{i % 7}\\sub{i % 3}\\file{i:05d}.dat".encode("latin-1")
+        header += struct.pack("<L", len(name) + 1) + name + b"\0"
+        header += struct.pack("<LL", len(stored), 1 if compressed else 0)
+        blob += stored
+    (directory / "resource.RFH").write_bytes(header)
+    (directory / "resource.RFD").write_bytes(blob)
+    return len(blob)
+
+
+def same_tree(a, b):
+    cmp = filecmp.dircmp(a, b)
+    if cmp.left_only or cmp.right_only or cmp.funny_files:
+        return False
+    _, mismatch, errors = filecmp.cmpfiles(a, b, cmp.common_files, shallow=False)
+    if mismatch or errors:
+        return False
+    return all(same_tree(os.path.join(a, d), os.path.join(b, d)) for d in cmp.common_dirs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--native", default=str(TOOLS.parent / "bin" / "rf_extract"), help="rf_extract binary")
+    parser.add_argument("--rfh", help="Real resource.RFH (with --rfd)")
+    parser.add_argument("--rfd", help="Real resource.RFD (with --rfh)")
+    parser.add_argument("--files", type=int, default=200, help="Files in the synthetic archive")
+    parser.add_argument("--avg-size", type=int, default=16384, help="Average synthetic file size in bytes")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        tmp = Path(tmp)
+        py_dir = tmp / "python"
+        native_dir = tmp / "native"
+        py_dir.mkdir()
+        native_dir.mkdir()
+
+        # The script works next to itself on fixed file names
+        if args.rfh and args.rfd:
+            shutil.copy(args.rfh, py_dir / "resource.RFH")
+            shutil.copy(args.rfd, py_dir / "resource.RFD")
+        else:
+            size = make_archive(py_dir, args.files, args.avg_size, args.seed)
+            print(f"Synthetic archive: {args.files} files, {size / 1e6:.1f} MB")
+        shutil.copy(TOOLS / "rf-extract.py", py_dir / "rf-extract.py")
+
+        start = time.perf_counter()
+        subprocess.run([sys.executable, str(py_dir / "rf-extract.py")], check=True, stdout=subprocess.DEVNULL)
+        py_time = time.perf_counter() - start
+
+        start = time.perf_counter()
+        subprocess.run([args.native, "-o", str(native_dir), str(py_dir / "resource.RFH"), str(py_dir / "resource.RFD")],
+                       check=True, stdout=subprocess.DEVNULL)
+        native_time = time.perf_counter() - start
+
+        identical = same_tree(py_dir / "resource_rfd", native_dir / "resource_rfd")
+        print(f"rf-extract.py: {py_time:8.3f} s")
+        print(f"rf_extract:    {native_time:8.3f} s  ({py_time / native_time:.0f}x faster)")
+        print("Output identical" if identical else "OUTPUT DIFFERS")
+        sys.exit(0 if identical else 1)
+
+
+if __name__ == "__main__":
+    main()